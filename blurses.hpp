@@ -10,11 +10,11 @@
 namespace Blurses {
 class Blurses {
 	public:
-		Blurses() {
+		Blurses(unsigned long frameInterval = 50) : _timer(frameInterval) {
 			_running = false;
 		}
 
-		void run(std::function<bool(Display&, std::list<Key>, unsigned long)> fn) {
+		void run(std::function<bool(Display&, KeyQueue&, unsigned long)> fn) {
 			_running = true;
 			_input.run();
 
@@ -22,6 +22,7 @@ class Blurses {
 				_display.update();
 				_running = fn(_display, _input.getBuffer(), _timer.getTime());
 				_display.draw();
+				_input.getBuffer().latency().flushed();
 				_timer.update();
 			}
 		}
@@ -30,12 +31,12 @@ class Blurses {
 			_running = false;
 		}
 
-		static void start(std::function<bool(Display&, std::list<Key>, unsigned long)> fn) {
+		static void start(std::function<bool(Display&, KeyQueue&, unsigned long)> fn, unsigned long frameInterval = 50) {
 			if (_instance) {
 				throw "Already instantiated";
 			}
 
-			_instance = new Blurses();
+			_instance = new Blurses(frameInterval);
 			std::signal(SIGINT, &Blurses::handleSigint);
 			_instance->run(fn);
 		}
@@ -62,8 +63,8 @@ namespace Blurses {
 		Blurses::Blurses::handleSigint(signum);
 	}
 
-	void start(std::function<bool(Display&, std::list<Key>, unsigned long)> fn) {
-		::Blurses::Blurses::start(fn);
+	void start(std::function<bool(Display&, KeyQueue&, unsigned long)> fn, unsigned long frameInterval = 50) {
+		::Blurses::Blurses::start(fn, frameInterval);
 	};
 }
 
@@ -5,73 +5,285 @@
 #include <list>
 #include <string>
 #include <cmath>
-#include "utfstring.hpp"
+#include <algorithm>
+#include "display.hpp"
 #include "graphics.hpp"
 
 namespace Blurses {
+// Braille dot bits by [y % 4][x % 2], see U+2800.
+const uint8_t BRAILLE_DOTS[4][2] = {
+	{0x01, 0x08},
+	{0x02, 0x10},
+	{0x04, 0x20},
+	{0x40, 0x80}
+};
+
+// Pixels packed in 2x4 blocks, one byte per terminal cell.
 class BrailleBuffer {
 	public:
 		BrailleBuffer(uint16_t width, uint16_t height)
 		: _width(width)
-		, _height(height) {
-			_buffer.resize(_width * _height, false);
+		, _height(height)
+		, _columns((width + 1) / 2)
+		, _rows((height + 3) / 4) {
+			_cells.resize(_columns * _rows, 0);
 		}
 
-		BrailleBuffer& set(uint16_t x, uint16_t y, bool value) {
+		BrailleBuffer& set(int x, int y, bool value) {
+			if (x < 0 || y < 0) { return *this; }
 			if (x >= _width) { return *this; }
 			if (y >= _height) { return *this; }
-			_buffer[y * _width + x] = value;
+
+			uint8_t &cell = _cells[(y / 4) * _columns + x / 2];
+
+			if (value) {
+				cell |= BRAILLE_DOTS[y % 4][x % 2];
+			} else {
+				cell &= ~BRAILLE_DOTS[y % 4][x % 2];
+			}
+
 			return *this;
 		}
 
+		bool get(int x, int y) const {
+			if (x < 0 || y < 0) { return false; }
+			if (x >= _width) { return false; }
+			if (y >= _height) { return false; }
+			return _cells[(y / 4) * _columns + x / 2] & BRAILLE_DOTS[y % 4][x % 2];
+		}
+
 		void clear() {
-			_buffer.assign(_width * _height, false);
+			std::fill(_cells.begin(), _cells.end(), 0);
 		}
 
 		void flip() {
-			_buffer.flip();
+			for (uint16_t row = 0; row < _rows; row++) {
+				for (uint16_t column = 0; column < _columns; column++) {
+					_cells[row * _columns + column] ^= mask(column, row);
+				}
+			}
 		}
 
-		void circle(uint16_t cx, uint16_t cy, float radius) {
-			Graphics::circle(cx, cy, radius, 16, [&](uint16_t x, uint16_t y) {
+		// Sets pixels x0 to x1 on row y. Cells fully inside the span get the
+		// same two dots, so the run between the end cells is a single fill.
+		void hline(int x0, int x1, int y) {
+			if (x0 > x1) { std::swap(x0, x1); }
+			if (y < 0 || y >= _height) { return; }
+			if (x1 < 0 || x0 >= _width) { return; }
+			x0 = std::max(x0, 0);
+			x1 = std::min<int>(x1, _width - 1);
+
+			const uint8_t left = BRAILLE_DOTS[y % 4][0];
+			const uint8_t right = BRAILLE_DOTS[y % 4][1];
+			uint8_t* cells = &_cells[(y / 4) * _columns];
+			uint16_t first = x0 / 2;
+			const uint16_t last = x1 / 2;
+
+			if (first == last) {
+				cells[first] |= (x0 % 2 == 0 ? left : 0) | (x1 % 2 == 1 ? right : 0);
+				return;
+			}
+
+			if (x0 % 2 == 1) {
+				cells[first++] |= right;
+			}
+
+			for (uint16_t column = first; column < last; column++) {
+				cells[column] |= left | right;
+			}
+
+			cells[last] |= left | (x1 % 2 == 1 ? right : 0);
+		}
+
+		void fillTriangle(float x0, float y0, float x1, float y1, float x2, float y2) {
+			const Point points[3] = {{x0, y0}, {x1, y1}, {x2, y2}};
+			fill(points, 3);
+		}
+
+		// Fills the inside of a polygon, by the even-odd rule. Any type with
+		// x and y members works as a point.
+		template<typename P>
+		void fillPolygon(const std::vector<P> &points) {
+			_points.clear();
+
+			for (const P &point : points) {
+				_points.push_back({static_cast<float>(point.x), static_cast<float>(point.y)});
+			}
+
+			fill(_points.data(), _points.size());
+		}
+
+		void thickLine(float x0, float y0, float x1, float y1, float thickness) {
+			const float dx = x1 - x0;
+			const float dy = y1 - y0;
+			const float length = std::sqrt(dx * dx + dy * dy);
+
+			if (length == 0 || thickness <= 1) {
+				line(std::lround(x0), std::lround(y0), std::lround(x1), std::lround(y1));
+				return;
+			}
+
+			const float nx = -dy / length * thickness / 2;
+			const float ny = dx / length * thickness / 2;
+			const Point points[4] = {
+				{x0 + nx, y0 + ny},
+				{x1 + nx, y1 + ny},
+				{x1 - nx, y1 - ny},
+				{x0 - nx, y0 - ny}
+			};
+
+			fill(points, 4);
+		}
+
+		// Sets pixels y0 to y1 in column x, a cell row at a time.
+		void vline(int x, int y0, int y1) {
+			if (y0 > y1) { std::swap(y0, y1); }
+			if (x < 0 || x >= _width) { return; }
+			if (y1 < 0 || y0 >= _height) { return; }
+			y0 = std::max(y0, 0);
+			y1 = std::min<int>(y1, _height - 1);
+
+			for (int row = y0 / 4; row <= y1 / 4; row++) {
+				uint8_t dots = 0;
+
+				for (int y = std::max(y0, row * 4); y <= y1 && y < row * 4 + 4; y++) {
+					dots |= BRAILLE_DOTS[y % 4][x % 2];
+				}
+
+				_cells[row * _columns + x / 2] |= dots;
+			}
+		}
+
+		// Moves everything left by the given number of pixels, clearing the
+		// columns that come in from the right.
+		void scroll(uint16_t pixels) {
+			const size_t shift = pixels / 2;
+
+			for (uint16_t row = 0; row < _rows; row++) {
+				uint8_t* cells = &_cells[row * _columns];
+
+				for (size_t column = 0; column < _columns; column++) {
+					const size_t from = column + shift;
+					const uint8_t first = from < _columns ? cells[from] : 0;
+
+					if (pixels % 2 == 0) {
+						cells[column] = first;
+					} else {
+						const uint8_t second = from + 1 < _columns ? cells[from + 1] : 0;
+						cells[column] = rightToLeft(first) | leftToRight(second);
+					}
+				}
+			}
+		}
+
+		void circle(int cx, int cy, float radius) {
+			ellipse(cx, cy, std::lround(radius), std::lround(radius));
+		}
+
+		void filledCircle(int cx, int cy, float radius) {
+			filledEllipse(cx, cy, std::lround(radius), std::lround(radius));
+		}
+
+		void ellipse(int cx, int cy, int rx, int ry) {
+			Graphics::ellipse(cx, cy, rx, ry, [&](int x, int y) {
 				set(x, y, true);
-			}, 1.0);
+			});
 		}
 
-		void line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-			Graphics::bresenham(x0, y0, x1, y1, [&](uint16_t x, uint16_t y) {
+		void filledEllipse(int cx, int cy, int rx, int ry) {
+			Graphics::filledEllipse(cx, cy, rx, ry, [&](int x0, int x1, int y) {
+				hline(x0, x1, y);
+			});
+		}
+
+		void line(int x0, int y0, int x1, int y1) {
+			Graphics::bresenham(x0, y0, x1, y1, _width, _height, [&](int x, int y) {
 				set(x, y, true);
 			});
 		}
 
-		std::list<std::list<std::string> > lines() {
-			std::list<std::list<std::string> > lines;
+		// Clears pixel column x.
+		void clearColumn(int x) {
+			if (x < 0 || x >= _width) { return; }
 
-			for (size_t i = 0; i < std::ceil(_height / 4.0); i++) {
-				std::vector<uint32_t> values(_width / 2, 0);
+			const uint8_t dots = x % 2 ? 0xb8 : 0x47;
 
-				for (size_t yc = 0; yc < 4; yc++) {
-					const size_t y = i * 4 + yc;
+			for (uint16_t row = 0; row < _rows; row++) {
+				_cells[row * _columns + x / 2] &= ~dots;
+			}
+		}
 
-					if (y >= _height) {
-						break;
-					}
+		// The dots of a cell's left column moved to its right column, and
+		// the other way around.
+		static uint8_t leftToRight(uint8_t dots) {
+			return ((dots & 0x07) << 3) | ((dots & 0x40) << 1);
+		}
+
+		static uint8_t rightToLeft(uint8_t dots) {
+			return ((dots & 0x38) >> 3) | ((dots & 0x80) >> 1);
+		}
+
+		uint16_t width() const {
+			return _width;
+		}
 
-					for (size_t x = 0; x < _width; x++) {
-						if (_buffer.at(y * _width + x)) {
-							if (yc == 3) {
-								values[x / 2] |= 0x40 << (x % 2);
-							} else {
-								values[x / 2] |= (1 << (x % 2) * 3) << yc;
-							}
-						}
+		uint16_t height() const {
+			return _height;
+		}
+
+		// Size in terminal cells.
+		uint16_t columns() const {
+			return _columns;
+		}
+
+		uint16_t rows() const {
+			return _rows;
+		}
+
+		uint8_t cell(uint16_t column, uint16_t row) const {
+			return _cells[row * _columns + column];
+		}
+
+		// UTF-8 encoding of the braille pattern for a cell, always 3 bytes.
+		static const char* glyph(uint8_t dots) {
+			static const Glyphs glyphs;
+			return glyphs.data[dots];
+		}
+
+		// Writes the buffer to the display with its top left cell at x, y.
+		void draw(Display &display, uint16_t x, uint16_t y, const CellAttributes &attrs) const {
+			const bool complete = attrs.isComplete();
+			Cell cell(attrs.buildCell());
+
+			if (_columns == 0) {
+				return;
+			}
+
+			for (uint16_t row = 0; row < _rows && y + row < display.height(); row++) {
+				const uint8_t* dots = &_cells[row * _columns];
+				Buffer::Span span = display.span(y + row, x, x + _columns - 1);
+
+				for (uint16_t column = 0; column < span.size(); column++) {
+					if (!complete) {
+						cell = span[column];
+						attrs.apply(cell);
+						cell.width = 1;
 					}
+
+					cell.data.assign(glyph(dots[column]), 3);
+					span.set(column, cell);
 				}
+			}
+		}
 
+		std::list<std::list<std::string> > lines() const {
+			std::list<std::list<std::string> > lines;
+
+			for (uint16_t row = 0; row < _rows; row++) {
 				std::list<std::string> line;
 
-				for (uint32_t value : values) {
-					line.push_back(utfstring::decode(0x2800 + value).str());
+				for (uint16_t column = 0; column < _columns; column++) {
+					line.push_back(std::string(glyph(cell(column, row)), 3));
 				}
 
 				lines.push_back(line);
@@ -81,9 +293,89 @@ class BrailleBuffer {
 		}
 
 	private:
+		struct Point {
+			float x;
+			float y;
+		};
+
+		struct Glyphs {
+			char data[256][3];
+
+			Glyphs() {
+				for (int i = 0; i < 256; i++) {
+					data[i][0] = static_cast<char>(0xe2);
+					data[i][1] = static_cast<char>(0xa0 | (i >> 6));
+					data[i][2] = static_cast<char>(0x80 | (i & 0x3f));
+				}
+			}
+		};
+
 		const uint16_t _width;
 		const uint16_t _height;
-		std::vector<bool> _buffer;
+		const uint16_t _columns;
+		const uint16_t _rows;
+		std::vector<uint8_t> _cells;
+		// Scratch space for fill(), kept to avoid allocating per shape.
+		std::vector<Point> _points;
+		std::vector<float> _crossings;
+
+		// Scanline fill, sampling each pixel at its center.
+		void fill(const Point* points, size_t count) {
+			if (count < 3) {
+				return;
+			}
+
+			float top = points[0].y;
+			float bottom = points[0].y;
+
+			for (size_t i = 1; i < count; i++) {
+				top = std::min(top, points[i].y);
+				bottom = std::max(bottom, points[i].y);
+			}
+
+			const int first = std::max(0, static_cast<int>(std::ceil(top - 0.5f)));
+			const int last = std::min(_height - 1, static_cast<int>(std::floor(bottom - 0.5f)));
+
+			for (int y = first; y <= last; y++) {
+				const float center = y + 0.5f;
+				_crossings.clear();
+
+				for (size_t i = 0; i < count; i++) {
+					const Point &a = points[i];
+					const Point &b = points[(i + 1) % count];
+
+					if ((a.y <= center) != (b.y <= center)) {
+						_crossings.push_back(a.x + (center - a.y) * (b.x - a.x) / (b.y - a.y));
+					}
+				}
+
+				std::sort(_crossings.begin(), _crossings.end());
+
+				for (size_t i = 0; i + 1 < _crossings.size(); i += 2) {
+					const int x0 = std::max(0, static_cast<int>(std::ceil(_crossings[i] - 0.5f)));
+					const int x1 = std::min(_width - 1, static_cast<int>(std::ceil(_crossings[i + 1] - 0.5f)) - 1);
+
+					if (x0 <= x1) {
+						hline(x0, x1, y);
+					}
+				}
+			}
+		}
+
+		// Dots of a cell that lie inside the buffer.
+		uint8_t mask(uint16_t column, uint16_t row) const {
+			uint8_t value = 0xff;
+
+			if (column * 2 + 1 >= _width) {
+				value &= 0x47;
+			}
+
+			for (uint16_t y = _height - row * 4; y < 4; y++) {
+				value &= ~(BRAILLE_DOTS[y][0] | BRAILLE_DOTS[y][1]);
+			}
+
+			return value;
+		}
 };
 };
 
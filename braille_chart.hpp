@@ -0,0 +1,227 @@
+#ifndef BRAILLE_CHART_HPP
+#define BRAILLE_CHART_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "braille_buffer.hpp"
+
+namespace Blurses {
+// Scrolling line chart. Every samplesPerPixel samples become one pixel
+// column spanning their min and max, connected to the previous column.
+// Pixel columns are kept in a ring, so a new column only clears and
+// rasterizes that column, and the scrolling happens while drawing. NaN
+// samples are skipped, a column without any other samples is left empty.
+class BrailleChart {
+	public:
+		BrailleChart(uint16_t columns, uint16_t rows, float min, float max, uint16_t samplesPerPixel = 1)
+			: _width(columns * 2)
+			, _height(rows * 4)
+			, _columns(columns)
+			, _rows(rows)
+			, _min(min)
+			, _max(max)
+			, _samples_per_pixel(std::max<uint16_t>(samplesPerPixel, 1))
+			, _pending(0)
+			, _filled(0)
+			, _head(0) { }
+
+		size_t addSeries(const Color &color) {
+			_series.push_back(Series(_width, _height, color));
+			return _series.size() - 1;
+		}
+
+		size_t seriesCount() const {
+			return _series.size();
+		}
+
+		// Adds one sample to each series.
+		void push(const float* values, size_t count) {
+			for (size_t i = 0; i < _series.size() && i < count; i++) {
+				Series &series = _series[i];
+
+				if (_pending == 0) {
+					series.bucket = {NAN, NAN, NAN};
+				}
+
+				if (std::isnan(values[i])) {
+					continue;
+				}
+
+				if (std::isnan(series.bucket.last)) {
+					series.bucket = {values[i], values[i], values[i]};
+				} else {
+					series.bucket.min = std::min(series.bucket.min, values[i]);
+					series.bucket.max = std::max(series.bucket.max, values[i]);
+					series.bucket.last = values[i];
+				}
+			}
+
+			if (++_pending == _samples_per_pixel) {
+				_pending = 0;
+				commit();
+			}
+		}
+
+		void push(float value) {
+			push(&value, 1);
+		}
+
+		// Rasterizes the kept history again with the new range.
+		void setRange(float min, float max) {
+			_min = min;
+			_max = max;
+
+			for (Series &series : _series) {
+				series.pixels.clear();
+
+				for (uint16_t x = 0; x < _filled; x++) {
+					const size_t index = (_head + _width - _filled + x) % _width;
+					const Bucket* previous = x > 0 ? &series.history[(index + _width - 1) % _width] : nullptr;
+					rasterize(series, index, series.history[index], previous);
+				}
+			}
+		}
+
+		uint16_t columns() const {
+			return _columns;
+		}
+
+		uint16_t rows() const {
+			return _rows;
+		}
+
+		// Cells with dots from several series take the color of the last one.
+		void draw(Display &display, uint16_t x, uint16_t y, const CellAttributes &attrs) const {
+			// Pixel column of the oldest sample.
+			const size_t offset = (_head + _width - _filled) % _width;
+
+			if (_columns == 0) {
+				return;
+			}
+
+			for (uint16_t row = 0; row < _rows && y + row < display.height(); row++) {
+				Buffer::Span span = display.span(y + row, x, x + _columns - 1);
+
+				for (uint16_t column = 0; column < span.size(); column++) {
+					uint8_t dots = 0;
+					const Series* top = nullptr;
+
+					for (const Series &series : _series) {
+						const uint8_t value = cell(series, (offset + column * 2) % _width, row);
+
+						if (value) {
+							dots |= value;
+							top = &series;
+						}
+					}
+
+					Cell cell = span[column];
+					attrs.apply(cell);
+
+					if (top) {
+						cell.fg = display.color(top->color);
+					}
+
+					cell.data.assign(BrailleBuffer::glyph(dots), 3);
+					cell.width = 1;
+					span.set(column, cell);
+				}
+			}
+		}
+
+	private:
+		struct Bucket {
+			float min;
+			float max;
+			float last;
+		};
+
+		struct Series {
+			Series(uint16_t width, uint16_t height, const Color &color)
+				: pixels(width, height)
+				, color(color)
+				, history(width)
+				, bucket({0, 0, 0}) { }
+
+			BrailleBuffer pixels;
+			Color color;
+			std::vector<Bucket> history;
+			Bucket bucket;
+		};
+
+		const uint16_t _width;
+		const uint16_t _height;
+		const uint16_t _columns;
+		const uint16_t _rows;
+		float _min;
+		float _max;
+		const uint16_t _samples_per_pixel;
+		uint16_t _pending;
+		uint16_t _filled;
+		size_t _head;
+		std::vector<Series> _series;
+
+		// The new column goes where the oldest one was, in pixel column _head.
+		void commit() {
+			const bool full = _filled == _width;
+
+			for (Series &series : _series) {
+				const Bucket* previous = _filled > 0 ? &series.history[(_head + _width - 1) % _width] : nullptr;
+
+				if (full) {
+					series.pixels.clearColumn(_head);
+				}
+
+				series.history[_head] = series.bucket;
+				rasterize(series, _head, series.bucket, previous);
+			}
+
+			if (!full) {
+				_filled++;
+			}
+
+			_head = (_head + 1) % _width;
+		}
+
+		// Dots of the cell whose left pixel column is x, which is odd when
+		// the ring has been turned by an odd number of columns.
+		uint8_t cell(const Series &series, size_t x, uint16_t row) const {
+			if (x % 2 == 0) {
+				return series.pixels.cell(x / 2, row);
+			}
+
+			const uint8_t left = series.pixels.cell(x / 2, row);
+			const uint8_t right = series.pixels.cell(((x + 1) % _width) / 2, row);
+			return BrailleBuffer::rightToLeft(left) | BrailleBuffer::leftToRight(right);
+		}
+
+		void rasterize(Series &series, uint16_t x, const Bucket &bucket, const Bucket* previous) {
+			if (std::isnan(bucket.last)) {
+				return;
+			}
+
+			uint16_t top = toY(bucket.max);
+			uint16_t bottom = toY(bucket.min);
+
+			if (previous && !std::isnan(previous->last)) {
+				const uint16_t y = toY(previous->last);
+				top = std::min(top, y);
+				bottom = std::max(bottom, y);
+			}
+
+			series.pixels.vline(x, top, bottom);
+		}
+
+		uint16_t toY(float value) const {
+			if (_max <= _min) {
+				return _height - 1;
+			}
+
+			const float t = std::min(std::max((value - _min) / (_max - _min), 0.0f), 1.0f);
+			return static_cast<uint16_t>(std::lround((1.0f - t) * (_height - 1)));
+		}
+};
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <list>
+#include <algorithm>
 #include "cell.hpp"
 #include "cell_attributes.hpp"
 
@@ -11,6 +12,120 @@ class Buffer {
 	typedef std::pair<uint16_t, uint16_t> Range;
 
 	public:
+		// Cells x to x + size() - 1 of one row, clipped to the buffer when
+		// created so writes through it skip the bounds checks. Writes keep
+		// wide characters whole the same way Buffer::set does.
+		class Span {
+			public:
+				Span() : _row(nullptr), _width(0), _x(0), _size(0) { }
+
+				Span(Cell* row, uint16_t width, uint16_t x, uint16_t size)
+					: _row(row)
+					, _width(width)
+					, _x(x)
+					, _size(size) { }
+
+				uint16_t x() const {
+					return _x;
+				}
+
+				uint16_t size() const {
+					return _size;
+				}
+
+				bool empty() const {
+					return _size == 0;
+				}
+
+				const Cell& operator[](uint16_t i) const {
+					return _row[_x + i];
+				}
+
+				// Writes cell at index i and returns the columns it took.
+				uint8_t set(uint16_t i, const Cell &cell) {
+					const uint16_t x = _x + i;
+
+					split(x);
+
+					if (!cell.isWide()) {
+						_row[x] = cell;
+						return 1;
+					}
+
+					if (i + 1 >= _size) {
+						// A wide character doesn't fit in the last column.
+						_row[x] = cell;
+						_row[x].data = " ";
+						_row[x].width = 1;
+						return 1;
+					}
+
+					split(x + 1);
+					_row[x] = cell;
+					_row[x + 1] = cell;
+					_row[x + 1].data.clear();
+					_row[x + 1].width = 0;
+					return 2;
+				}
+
+				// Fills the span with a cell that takes one column.
+				void fill(const Cell &cell) {
+					if (_size == 0) {
+						return;
+					}
+
+					split(_x);
+					split(_x + _size - 1);
+					std::fill(_row + _x, _row + _x + _size, cell);
+				}
+
+				// Copies size() cells laid out as in a row of the buffer, with
+				// a continuation cell after every wide one. Wide characters cut
+				// by either end of the span are blanked.
+				void assign(const Cell* cells) {
+					if (_size == 0) {
+						return;
+					}
+
+					split(_x);
+					split(_x + _size - 1);
+					std::copy(cells, cells + _size, _row + _x);
+
+					if (_row[_x].isContinuation()) {
+						blank(_row[_x]);
+					}
+
+					if (_row[_x + _size - 1].isWide()) {
+						blank(_row[_x + _size - 1]);
+					}
+				}
+
+				// Writes cells one after the other until the span is full.
+				void copy(const Cell* cells, size_t count) {
+					uint16_t i = 0;
+
+					for (size_t j = 0; j < count && i < _size; j++) {
+						i += set(i, cells[j]);
+					}
+				}
+
+			private:
+				Cell* _row;
+				uint16_t _width;
+				uint16_t _x;
+				uint16_t _size;
+
+				void split(uint16_t x) {
+					const Cell &cell = _row[x];
+
+					if (cell.isContinuation() && x > 0) {
+						blank(_row[x - 1]);
+					} else if (cell.isWide() && x + 1 < _width) {
+						blank(_row[x + 1]);
+					}
+				}
+		};
+
 		Buffer(uint16_t width, uint16_t height)
 			: _width(width)
 			, _height(height)
@@ -32,7 +147,34 @@ class Buffer {
 
 			const size_t index = this->getIndex(x, y);
 
+			if (cell.isWide() && x + 1 >= _width) {
+				// A wide character doesn't fit in the last column.
+				cell.data = " ";
+				cell.width = 1;
+			}
+
+			splitWide(index, x);
 			_buffer.at(index) = cell;
+
+			if (cell.isWide()) {
+				splitWide(index + 1, x + 1);
+				Cell &continuation = _buffer.at(index + 1);
+				continuation = cell;
+				continuation.data.clear();
+				continuation.width = 0;
+			}
+		}
+
+		// Columns x0 to x1 of row y, clipped to the buffer.
+		Span span(int y, int x0, int x1) {
+			if (x1 < x0) { std::swap(x0, x1); }
+			if (y < 0 || y >= _height) { return Span(); }
+			if (x1 < 0 || x0 >= _width) { return Span(); }
+
+			x0 = std::max(x0, 0);
+			x1 = std::min(x1, _width - 1);
+
+			return Span(&_buffer[y * _width], _width, x0, x1 - x0 + 1);
 		}
 
 		void redraw(bool showCursor) {
@@ -42,6 +184,12 @@ class Buffer {
 			print(showCursor);
 		}
 
+		// Starts the frame with what the last one printed, for when nothing
+		// has changed.
+		void repeat() {
+			_buffer.assign(_prev_buffer.begin(), _prev_buffer.end());
+		}
+
 		void print(bool showCursor) {
 			std::string buf;
 
@@ -69,6 +217,11 @@ class Buffer {
 
 					for (uint16_t x = min_x; x < max_x; x++) {
 						const Cell &cell = _buffer[row_index + x];
+
+						if (cell.isContinuation()) {
+							continue;
+						}
+
 						printCell(row_buf, cell, prev);
 						prev = &(cell);
 					}
@@ -101,6 +254,22 @@ class Buffer {
 		uint16_t _cursorY;
 		std::vector<Cell> _buffer, _prev_buffer;
 
+		// Overwriting one half of a wide character blanks the other half.
+		void splitWide(size_t index, uint16_t x) {
+			const Cell &cell = _buffer[index];
+
+			if (cell.isContinuation() && x > 0) {
+				blank(_buffer[index - 1]);
+			} else if (cell.isWide() && x + 1 < _width) {
+				blank(_buffer[index + 1]);
+			}
+		}
+
+		static void blank(Cell &cell) {
+			cell.data = " ";
+			cell.width = 1;
+		}
+
 		void printCell(std::string& str, const Cell& cell, const Cell* prev) const {
 			toggle(str, cell.isItalic, prev && prev->isItalic, "\033[3m", "\033[23m");
 			toggle(str, cell.isUnderline, prev && prev->isUnderline, "\033[4m", "\033[24m");
@@ -180,6 +349,18 @@ class Buffer {
 				ranges.push_back({first, _width});
 			}
 
+			// Wide characters are always printed whole, so the cursor lands
+			// where the next range expects it.
+			for (Range &range : ranges) {
+				if (range.first > 0 && _buffer[min + range.first].isContinuation()) {
+					range.first--;
+				}
+
+				if (range.second < _width && _buffer[min + range.second - 1].isWide()) {
+					range.second++;
+				}
+			}
+
 			return optimizeRanges(ranges);
 		}
 
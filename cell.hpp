@@ -8,18 +8,24 @@ namespace Blurses {
 struct Cell {
 	Cell() : Cell(RealColor::off(), RealColor::off(), " ", false, false) { }
 
-	Cell(RealColor fg, RealColor bg, std::string data, bool isItalic, bool isUnderline)
+	Cell(RealColor fg, RealColor bg, std::string data, bool isItalic, bool isUnderline, uint8_t width = 1)
 		: fg(fg)
 		, bg(bg)
 		, data(data)
 		, isItalic(isItalic),
-		isUnderline(isUnderline) { }
+		isUnderline(isUnderline),
+		width(width) { }
+
+	Cell(const Cell &other) = default;
 
 	RealColor fg;
 	RealColor bg;
 	std::string data;
 	bool isItalic:1;
 	bool isUnderline:2;
+	// Columns taken by data. A wide cell is followed by a continuation cell
+	// with width 0 that is never printed.
+	uint8_t width:2;
 
 	Cell& operator=(const Cell &other) {
 		this->fg = other.fg;
@@ -27,6 +33,7 @@ struct Cell {
 		this->data = other.data;
 		this->isItalic = other.isItalic;
 		this->isUnderline = other.isUnderline;
+		this->width = other.width;
 		return *this;
 	}
 
@@ -36,10 +43,19 @@ struct Cell {
 			this->bg == other.bg &&
 			this->data == other.data &&
 			this->isItalic == other.isItalic &&
-			this->isUnderline == other.isUnderline
+			this->isUnderline == other.isUnderline &&
+			this->width == other.width
 	   );
 	}
 
+	bool isContinuation() const {
+		return width == 0;
+	}
+
+	bool isWide() const {
+		return width == 2;
+	}
+
 	bool operator!=(const Cell &other) const {
 		return !(other == *this);
 	}
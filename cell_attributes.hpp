@@ -12,7 +12,11 @@ class CellAttributes {
 			, _fg(0xffffff)
 			, _bg(0x000000)
 			, _is_italic(false)
-			, _is_underline(false) {}
+			, _is_underline(false)
+			, _isset_fg(false)
+			, _isset_bg(false)
+			, _isset_is_italic(false)
+			, _isset_is_underline(false) {}
 
 		CellAttributes(const CellAttributes &other)
 			: _color(other._color)
@@ -63,6 +67,47 @@ class CellAttributes {
 			return cell;
 		}
 
+		// Same as apply(), taking the values from a cell made by
+		// buildCell() instead of converting the colors again.
+		Cell& applyFrom(const Cell& built, Cell& cell) const {
+			if (_isset_fg) { cell.fg = built.fg; }
+			if (_isset_bg) { cell.bg = built.bg; }
+			if (_isset_is_italic) { cell.isItalic = built.isItalic; }
+			if (_isset_is_underline) { cell.isUnderline = built.isUnderline; }
+			return cell;
+		}
+
+		// Whether apply() overwrites every attribute of a cell.
+		bool isComplete() const {
+			return _isset_fg && _isset_bg && _isset_is_italic && _isset_is_underline;
+		}
+
+		bool operator==(const CellAttributes &other) const {
+			return (
+				_isset_fg == other._isset_fg &&
+				_isset_bg == other._isset_bg &&
+				_isset_is_italic == other._isset_is_italic &&
+				_isset_is_underline == other._isset_is_underline &&
+				(!_isset_fg || _fg == other._fg) &&
+				(!_isset_bg || _bg == other._bg) &&
+				(!_isset_is_italic || _is_italic == other._is_italic) &&
+				(!_isset_is_underline || _is_underline == other._is_underline)
+			);
+		}
+
+		bool operator!=(const CellAttributes &other) const {
+			return !(*this == other);
+		}
+
+		size_t hash() const {
+			size_t value = 0;
+			if (_isset_fg) { value ^= 0x1000000 | (_fg.r << 16) | (_fg.g << 8) | _fg.b; }
+			if (_isset_bg) { value ^= (0x1000000 | (_bg.r << 16) | (_bg.g << 8) | _bg.b) * 31; }
+			if (_isset_is_italic) { value ^= _is_italic ? 0x2000000 : 0x4000000; }
+			if (_isset_is_underline) { value ^= _is_underline ? 0x8000000 : 0x10000000; }
+			return value;
+		}
+
 	private:
 		const ColorWrapper& _color;
 		Color _fg;
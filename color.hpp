@@ -268,9 +268,9 @@ class Color256 : public AbstractColor {
 class ColorWrapper {
 	public:
 		ColorWrapper() {
-			if (std::string(std::getenv("TERM_PROGRAM")) == "iTerm.app") {
+			if (env("TERM_PROGRAM") == "iTerm.app") {
 				_color = new TrueColor();
-			} else if (ends_with(std::getenv("TERM"), "256color")) {
+			} else if (ends_with(env("TERM"), "256color")) {
 				_color = new Color256();
 			} else {
 				_color = new Color16();
@@ -288,6 +288,12 @@ class ColorWrapper {
 	private:
 		AbstractColor *_color;
 
+		// Empty when unset.
+		static std::string env(const char *name) {
+			const char *value = std::getenv(name);
+			return value ? value : "";
+		}
+
 		bool ends_with(const std::string &value, const std::string &ending) {
 			if (ending.size() > value.size()) {
 				return false;
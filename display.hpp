@@ -24,6 +24,12 @@ class Display {
 			}
 		}
 
+		void repeat() {
+			if (_buffer) {
+				_buffer->repeat();
+			}
+		}
+
 		void update() {
 			ioctl(STDOUT_FILENO, TIOCGWINSZ, &_winsize);
 
@@ -35,6 +41,18 @@ class Display {
 			}
 		}
 
+		// Sets the size without asking the terminal, for drawing off screen.
+		void resize(uint16_t width, uint16_t height) {
+			_width = width;
+			_height = height;
+
+			if (this->_buffer) {
+				delete this->_buffer;
+			}
+
+			this->_buffer = new Buffer(width, height);
+		}
+
 		uint16_t width() const {
 			return _width;
 		}
@@ -51,6 +69,10 @@ class Display {
 			return getBuffer().get(x, y);
 		}
 
+		Buffer::Span span(int y, int x0, int x1) {
+			return getBuffer().span(y, x0, x1);
+		}
+
 		void setCursorPosition(uint16_t x, uint16_t y) {
 			getBuffer().setCursorPosition(x, y);
 		}
@@ -85,17 +107,6 @@ class Display {
 		ColorWrapper _color;
 		bool _showCursor;
 
-		void resize(uint16_t width, uint16_t height) {
-			_width = width;
-			_height = height;
-
-			if (this->_buffer) {
-				delete this->_buffer;
-			}
-
-			this->_buffer = new Buffer(width, height);
-		}
-
 		Buffer& getBuffer() {
 			return *_buffer;
 		}
@@ -105,12 +116,12 @@ class Display {
 #include "primitives.hpp"
 
 namespace Blurses {
-Display::Display() : _width(0), _height(0), _buffer(0), _showCursor(true) {
+inline Display::Display() : _width(0), _height(0), _buffer(0), _showCursor(true) {
 	_primitives = new Blurses::Primitives(*this);
 	std::cout << "\033[?1047h\033[H\033[J";
 }
 
-Display::~Display() {
+inline Display::~Display() {
 	delete _primitives;
 
 	if (_buffer) {
@@ -0,0 +1,359 @@
+#ifndef DISPLAY_LIST_HPP
+#define DISPLAY_LIST_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "display.hpp"
+#include "braille_buffer.hpp"
+#include "graphics.hpp"
+
+namespace Blurses {
+// Draw commands recorded for a frame and painted in one pass. Commands
+// that are off-screen or covered by a later filled rect are dropped, the
+// rest are executed a row at a time in the order they were recorded, so
+// each row of the buffer is written while it's in cache. When a frame
+// records the same commands as the last painted one, painting is skipped.
+class DisplayList {
+	public:
+		DisplayList()
+			: _hash(BASIS)
+			, _painted_hash(0)
+			, _painted_width(0)
+			, _painted_height(0)
+			, _culled(0) { }
+
+		DisplayList& text(int x, int y, const utfstring &text, const CellAttributes &attrs) {
+			Command &command = add(TEXT, x, y, x + text.width() - 1, y, attrs);
+			command.offset = _text.size();
+			command.size = text.size();
+			_text.append(text.data(), text.size());
+
+			for (size_t i = 0; i < text.size(); i++) {
+				mix(static_cast<uint8_t>(text.data()[i]));
+			}
+
+			return *this;
+		}
+
+		DisplayList& rect(int x0, int y0, int x1, int y1, const CellAttributes &attrs) {
+			add(RECT, x0, y0, x1, y1, attrs);
+			return *this;
+		}
+
+		DisplayList& filledRect(int x0, int y0, int x1, int y1, const CellAttributes &attrs) {
+			add(FILLED_RECT, x0, y0, x1, y1, attrs);
+			return *this;
+		}
+
+		DisplayList& line(int x0, int y0, int x1, int y1, const CellAttributes &attrs) {
+			Command &command = add(LINE, x0, y0, x1, y1, attrs);
+			// Keep the direction, the bounds lose it.
+			command.from_x = x0;
+			command.from_y = y0;
+			command.to_x = x1;
+			command.to_y = y1;
+			return *this;
+		}
+
+		// The buffer is read when painting and must outlive the list.
+		DisplayList& braille(int x, int y, const BrailleBuffer &buffer, const CellAttributes &attrs) {
+			Command &command = add(BRAILLE, x, y, x + buffer.columns() - 1, y + buffer.rows() - 1, attrs);
+			command.braille = &buffer;
+
+			for (uint16_t row = 0; row < buffer.rows(); row++) {
+				for (uint16_t column = 0; column < buffer.columns(); column++) {
+					mix(buffer.cell(column, row));
+				}
+			}
+
+			return *this;
+		}
+
+		// Starts recording a new frame.
+		void clear() {
+			_commands.clear();
+			_attrs.clear();
+			_cells.clear();
+			_text.clear();
+			_hash = BASIS;
+		}
+
+		size_t size() const {
+			return _commands.size();
+		}
+
+		size_t hash() const {
+			return _hash;
+		}
+
+		// Commands left out of the last paint.
+		size_t culled() const {
+			return _culled;
+		}
+
+		// Paints the recorded commands, unless they are the same as the last
+		// painted ones, in which case the last frame is repeated. Returns
+		// whether anything was painted. Only valid when nothing else draws
+		// to the display.
+		bool paint(Display &display) {
+			if (_hash == _painted_hash && display.width() == _painted_width && display.height() == _painted_height) {
+				display.repeat();
+				return false;
+			}
+
+			_painted_hash = _hash;
+			_painted_width = display.width();
+			_painted_height = display.height();
+
+			cull(display);
+			execute(display);
+
+			return true;
+		}
+
+	private:
+		enum TYPE {
+			TEXT,
+			RECT,
+			FILLED_RECT,
+			LINE,
+			BRAILLE
+		};
+
+		struct Command {
+			TYPE type;
+			int x0, y0, x1, y1;
+			size_t attrs;
+			size_t offset;
+			size_t size;
+			int from_x, from_y, to_x, to_y;
+			const BrailleBuffer* braille;
+		};
+
+		// Part of a line on one row.
+		struct Run {
+			int y;
+			int x0;
+			int x1;
+		};
+
+		static const size_t BASIS = 14695981039346656037ULL;
+
+		std::vector<Command> _commands;
+		std::vector<CellAttributes> _attrs;
+		std::vector<Cell> _cells;
+		std::string _text;
+		size_t _hash;
+		size_t _painted_hash;
+		uint16_t _painted_width;
+		uint16_t _painted_height;
+		size_t _culled;
+
+		// Scratch space for painting, kept between frames.
+		std::vector<size_t> _visible;
+		std::vector<size_t> _occluders;
+		std::vector<size_t> _active;
+		std::vector<size_t> _run_start;
+		std::vector<size_t> _run_end;
+		std::vector<Run> _runs;
+
+		void mix(size_t value) {
+			_hash ^= value;
+			_hash *= 1099511628211ULL;
+		}
+
+		Command& add(TYPE type, int x0, int y0, int x1, int y1, const CellAttributes &attrs) {
+			Command command = {};
+			command.type = type;
+			command.x0 = std::min(x0, x1);
+			command.y0 = std::min(y0, y1);
+			command.x1 = std::max(x0, x1);
+			command.y1 = std::max(y0, y1);
+			command.attrs = _attrs.size();
+
+			_attrs.push_back(attrs);
+			_cells.push_back(attrs.buildCell());
+
+			mix(type);
+			mix(x0);
+			mix(y0);
+			mix(x1);
+			mix(y1);
+			mix(attrs.hash());
+
+			_commands.push_back(command);
+			return _commands.back();
+		}
+
+		// Walks the commands from the last one, keeping the filled rects seen
+		// so far, so each command is only tested against later rects that
+		// aren't already covered by another one.
+		void cull(Display &display) {
+			_visible.clear();
+			_occluders.clear();
+
+			for (size_t i = _commands.size(); i-- > 0;) {
+				const Command &command = _commands[i];
+
+				if (command.x1 < 0 || command.y1 < 0) { continue; }
+				if (command.x0 >= display.width() || command.y0 >= display.height()) { continue; }
+				if (occluded(command)) { continue; }
+
+				_visible.push_back(i);
+
+				if (command.type == FILLED_RECT) {
+					_occluders.erase(std::remove_if(_occluders.begin(), _occluders.end(), [&](size_t index) {
+						return contains(command, _commands[index]);
+					}), _occluders.end());
+
+					_occluders.push_back(i);
+				}
+			}
+
+			std::reverse(_visible.begin(), _visible.end());
+			_culled = _commands.size() - _visible.size();
+		}
+
+		bool occluded(const Command &command) const {
+			for (size_t index : _occluders) {
+				if (contains(_commands[index], command)) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		static bool contains(const Command &outer, const Command &inner) {
+			return
+				outer.x0 <= inner.x0 && outer.x1 >= inner.x1 &&
+				outer.y0 <= inner.y0 && outer.y1 >= inner.y1;
+		}
+
+		void execute(Display &display) {
+			rasterizeLines(display);
+
+			std::stable_sort(_visible.begin(), _visible.end(), [&](size_t a, size_t b) {
+				return _commands[a].y0 < _commands[b].y0;
+			});
+
+			_active.clear();
+			size_t next = 0;
+
+			for (int y = 0; y < display.height(); y++) {
+				if (_active.empty()) {
+					if (next == _visible.size()) {
+						break;
+					}
+
+					y = std::max(y, _commands[_visible[next]].y0);
+				}
+
+				while (next < _visible.size() && _commands[_visible[next]].y0 <= y) {
+					const size_t index = _visible[next++];
+					_active.insert(std::lower_bound(_active.begin(), _active.end(), index), index);
+				}
+
+				for (size_t index : _active) {
+					drawRow(display, index, y);
+				}
+
+				_active.erase(std::remove_if(_active.begin(), _active.end(), [&](size_t index) {
+					return _commands[index].y1 <= y;
+				}), _active.end());
+			}
+		}
+
+		// Lines are clipped and split into runs per row, in row order.
+		void rasterizeLines(Display &display) {
+			_runs.clear();
+			_run_start.assign(_commands.size(), 0);
+			_run_end.assign(_commands.size(), 0);
+
+			for (size_t index : _visible) {
+				const Command &command = _commands[index];
+
+				if (command.type != LINE) {
+					continue;
+				}
+
+				const size_t start = _runs.size();
+
+				Graphics::bresenham(command.from_x, command.from_y, command.to_x, command.to_y, display.width(), display.height(), [&](int x, int y) {
+					if (_runs.size() > start && _runs.back().y == y) {
+						_runs.back().x0 = std::min(_runs.back().x0, x);
+						_runs.back().x1 = std::max(_runs.back().x1, x);
+					} else {
+						_runs.push_back({y, x, x});
+					}
+				});
+
+				if (_runs.size() > start && _runs[start].y > _runs.back().y) {
+					std::reverse(_runs.begin() + start, _runs.end());
+				}
+
+				_run_start[index] = start;
+				_run_end[index] = _runs.size();
+			}
+		}
+
+		void drawRow(Display &display, size_t index, int y) {
+			const Command &command = _commands[index];
+			const Cell &cell = _cells[command.attrs];
+
+			switch (command.type) {
+				case TEXT: {
+					const char* start = _text.data() + command.offset;
+					display.primitives().text(command.x0, y, utfstring::grapheme_range(start, start + command.size), _attrs[command.attrs]);
+					break;
+				}
+				case FILLED_RECT:
+					display.span(y, command.x0, command.x1).fill(cell);
+					break;
+				case RECT:
+					if (y == command.y0 || y == command.y1) {
+						display.span(y, command.x0, command.x1).fill(cell);
+					} else {
+						display.span(y, command.x0, command.x0).fill(cell);
+						display.span(y, command.x1, command.x1).fill(cell);
+					}
+					break;
+				case LINE:
+					while (_run_start[index] < _run_end[index] && _runs[_run_start[index]].y < y) {
+						_run_start[index]++;
+					}
+
+					if (_run_start[index] < _run_end[index] && _runs[_run_start[index]].y == y) {
+						const Run &run = _runs[_run_start[index]];
+						display.span(y, run.x0, run.x1).fill(cell);
+					}
+					break;
+				case BRAILLE:
+					drawBrailleRow(display, command, y);
+					break;
+			}
+		}
+
+		void drawBrailleRow(Display &display, const Command &command, int y) {
+			const CellAttributes &attrs = _attrs[command.attrs];
+			const bool complete = attrs.isComplete();
+			const uint16_t row = y - command.y0;
+			Buffer::Span span = display.span(y, command.x0, command.x1);
+			Cell cell = _cells[command.attrs];
+
+			for (uint16_t i = 0; i < span.size(); i++) {
+				if (!complete) {
+					cell = span[i];
+					attrs.apply(cell);
+				}
+
+				cell.data.assign(BrailleBuffer::glyph(command.braille->cell(span.x() + i - command.x0, row)), 3);
+				cell.width = 1;
+				span.set(i, cell);
+			}
+		}
+};
+};
+
+#endif
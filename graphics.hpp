@@ -3,11 +3,15 @@
 
 #include <functional>
 #include <cmath>
+#include <algorithm>
 
 namespace Graphics {
-	typedef std::function<void(uint16_t, uint16_t)> callback_func;
+	typedef std::function<void(int, int)> callback_func;
 
-	void bresenham(int x0, int y0, int x1, int y1, callback_func fn) {
+	// The plotters are template parameters so they can be inlined into the
+	// loops. The callback_func overloads below remain for existing callers.
+	template<typename Plot>
+	inline void bresenham(int x0, int y0, int x1, int y1, Plot&& fn) {
 		bool steep = false;
 
 		if (std::abs(x0 - x1) < std::abs(y0 - y1)) {
@@ -46,17 +50,195 @@ namespace Graphics {
 		}
 	}
 
-	static void circle(uint16_t cx, uint16_t cy, float radius, float detail, callback_func fn, float y_multiply = 0.5) {
-		for (uint16_t i = 0; i < detail; i++) {
-			float a0 = i / detail;
-			float x0 = cx + std::cos(a0 * M_PI * 2) * radius;
-			float y0 = cy + std::sin(a0 * M_PI * 2) * radius * y_multiply;
-			float a1 = (i + 1) / detail;
-			float x1 = cx + std::cos(a1 * M_PI * 2) * radius;
-			float y1 = cy + std::sin(a1 * M_PI * 2) * radius * y_multiply;
-			bresenham(round(x0), round(y0), round(x1), round(y1), fn);
+	// Division rounding towards negative infinity, for b > 0.
+	inline long long floorDiv(long long a, long long b) {
+		return a >= 0 ? a / b : -((-a + b - 1) / b);
+	}
+
+	// Draws only the part of the line inside width x height, so the cost
+	// follows the visible pixels rather than the line's full length. The
+	// steps before the first visible pixel are skipped arithmetically, so
+	// the pixels drawn are exactly the visible ones of the whole line.
+	// Coordinates up to about a billion either way stay within 64 bits.
+	template<typename Plot>
+	inline void bresenham(int x0, int y0, int x1, int y1, int width, int height, Plot&& fn) {
+		bool steep = false;
+
+		if (std::abs((long long)x0 - x1) < std::abs((long long)y0 - y1)) {
+			std::swap(x0, y0);
+			std::swap(x1, y1);
+			std::swap(width, height);
+			steep = true;
+		}
+
+		if (x0 > x1) {
+			std::swap(x0, x1);
+			std::swap(y0, y1);
+		}
+
+		// The pixel k steps from x0 is at y0 +- n, where n is the number of
+		// times the error went over dx, ceil((2 * k * ady - dx) / (2 * dx)).
+		const long long dx = (long long)x1 - x0;
+		const long long ady = std::abs((long long)y1 - y0);
+		const int ystep = y1 > y0 ? 1 : -1;
+		// The range of n that keeps y inside 0 to height - 1.
+		const long long nmin = ystep > 0 ? -(long long)y0 : (long long)y0 - (height - 1);
+		const long long nmax = ystep > 0 ? (long long)height - 1 - y0 : y0;
+
+		long long kstart = std::max(0LL, -(long long)x0);
+		long long kend = std::min(dx, (long long)width - 1 - x0);
+
+		if (ady == 0) {
+			if (nmin > 0 || nmax < 0) {
+				return;
+			}
+		} else {
+			kstart = std::max(kstart, floorDiv(2 * dx * (nmin - 1) + dx, 2 * ady) + 1);
+			kend = std::min(kend, floorDiv(2 * dx * nmax + dx, 2 * ady));
+		}
+
+		if (kstart > kend) {
+			return;
+		}
+
+		const long long n = dx == 0 ? 0 : -floorDiv(dx - 2 * kstart * ady, 2 * dx);
+		const long long derror = ady * 2;
+		long long error = 2 * kstart * ady - 2 * dx * n;
+		int y = y0 + ystep * n;
+
+		for (int x = x0 + kstart; x <= x0 + kend; x++) {
+			if (steep) {
+				fn(y, x);
+			} else {
+				fn(x, y);
+			}
+
+			error += derror;
+
+			if (error > dx) {
+				y += ystep;
+				error -= dx * 2;
+			}
+		}
+	}
+
+	// Walks the edge of an ellipse centered at 0, 0 through the quadrant
+	// with x, y >= 0 by the integer midpoint algorithm, from 0, ry to rx, 0.
+	// A zero radius gives a straight line along the other axis.
+	template<typename Plot>
+	inline void ellipseQuadrant(int rx, int ry, Plot&& fn) {
+		if (rx < 0 || ry < 0) {
+			return;
+		}
+
+		if (rx == 0) {
+			for (int y = ry; y >= 0; y--) {
+				fn(0, y);
+			}
+
+			return;
+		}
+
+		if (ry == 0) {
+			for (int x = 0; x <= rx; x++) {
+				fn(x, 0);
+			}
+
+			return;
+		}
+
+		const long rx2 = long(rx) * rx;
+		const long ry2 = long(ry) * ry;
+		long x = 0;
+		long y = ry;
+		long px = 0;
+		long py = 2 * rx2 * y;
+		long p = ry2 - rx2 * ry + rx2 / 4;
+
+		while (px < py) {
+			fn(x, y);
+			x++;
+			px += 2 * ry2;
+
+			if (p < 0) {
+				p += ry2 + px;
+			} else {
+				y--;
+				py -= 2 * rx2;
+				p += ry2 + px - py;
+			}
+		}
+
+		p = ry2 * (x * x + x) + ry2 / 4 + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
+
+		while (y >= 0) {
+			fn(x, y);
+			y--;
+			py -= 2 * rx2;
+
+			if (p > 0) {
+				p += rx2 - py;
+			} else {
+				x++;
+				px += 2 * ry2;
+				p += rx2 - py + px;
+			}
+		}
+	}
+
+	template<typename Plot>
+	inline void ellipse(int cx, int cy, int rx, int ry, Plot&& fn) {
+		ellipseQuadrant(rx, ry, [&](int x, int y) {
+			fn(cx + x, cy + y);
+			fn(cx - x, cy + y);
+			fn(cx + x, cy - y);
+			fn(cx - x, cy - y);
+		});
+	}
+
+	// Calls fn(x0, x1, y) once for every row of the ellipse.
+	template<typename Span>
+	inline void filledEllipse(int cx, int cy, int rx, int ry, Span&& fn) {
+		int row = ry;
+		int extent = 0;
+
+		auto emit = [&]() {
+			fn(cx - extent, cx + extent, cy + row);
+
+			if (row != 0) {
+				fn(cx - extent, cx + extent, cy - row);
+			}
+		};
+
+		ellipseQuadrant(rx, ry, [&](int x, int y) {
+			if (y != row) {
+				emit();
+				row = y;
+			}
+
+			extent = x;
+		});
+
+		if (rx >= 0 && ry >= 0) {
+			emit();
 		}
 	}
+
+	// Circles are ellipses with the y radius scaled by y_multiply, which
+	// corrects for the aspect ratio of terminal cells. detail is unused and
+	// only kept for existing callers.
+	template<typename Plot>
+	inline void circle(int cx, int cy, float radius, float /*detail*/, Plot&& fn, float y_multiply = 0.5) {
+		ellipse(cx, cy, std::lround(radius), std::lround(radius * y_multiply), fn);
+	}
+
+	inline void bresenham(int x0, int y0, int x1, int y1, callback_func fn) {
+		bresenham<callback_func&>(x0, y0, x1, y1, fn);
+	}
+
+	inline void circle(int cx, int cy, float radius, float detail, callback_func fn, float y_multiply = 0.5) {
+		circle<callback_func&>(cx, cy, radius, detail, fn, y_multiply);
+	}
 };
 
 #endif
@@ -2,110 +2,318 @@
 #define INPUT_HPP
 
 #include <unistd.h>
+#include <fcntl.h>
 #include <termios.h>
-#include <list>
+#include <poll.h>
+#include <array>
 #include <thread>
+#include <atomic>
 #include <iostream>
 #include <locale>
+#include <stdexcept>
 #include "utfstring.hpp"
 #include "key.hpp"
+#include "ring_buffer.hpp"
+#include "input_parser.hpp"
+#include "utf8_decoder.hpp"
+#include "latency.hpp"
 
 namespace Blurses {
-class Input {
-	class InputState {
-		public:
-			InputState(Input& input) : _input(input) {
-				reset();
+class KeyQueue : public RingBuffer<Key, 1024> {
+	public:
+		// Like RingBuffer::drain, but consecutive MOUSE_MOVE keys are collapsed
+		// into the last one so only the latest pointer position is delivered.
+		template <typename F>
+		size_t drain(F fn) {
+			Key motion;
+			bool has_motion = false;
+
+			const size_t count = RingBuffer::drain([&](const Key& key) {
+				if (key.type == Key::MOUSE_MOVE) {
+					motion = key;
+					has_motion = true;
+					return;
+				}
+
+				if (has_motion) {
+					deliver(motion, fn);
+					has_motion = false;
+				}
+
+				deliver(key, fn);
+			});
+
+			if (has_motion) {
+				deliver(motion, fn);
 			}
 
-			bool handle(const char *str, size_t len) {
-				const char c = str[0];
+			return count;
+		}
 
-				if (c == 0x1b) {
-					if (len > 1) {
-						_escape_count++;
-						return true;
-					}
+		Latency& latency() {
+			return _latency;
+		}
 
-					reset();
-					_input.pushBuffer(Key(Key::KEY_ESCAPE));
-					return true;
-				}
+	private:
+		Latency _latency;
 
-				if (_escape_count && _in_bracket) {
-					if (c >= '0' && c <= '9') {
-						_vt[strlen(_vt) % sizeof _vt] = c;
-						return true;
-					}
+		template <typename F>
+		void deliver(const Key& key, F& fn) {
+			_latency.delivered(key.time);
+			fn(key);
+		}
+};
 
-					if (c == '~') {
-						switch (atoi(_vt)) {
-							case 1: _input.pushBuffer(Key(Key::KEY_HOME)); break;
-							case 3: _input.pushBuffer(Key(Key::KEY_DELETE)); break;
-							case 4: _input.pushBuffer(Key(Key::KEY_END)); break;
-						}
-					} else {
-						if (_escape_count == 2) {
-								switch (c) {
-									case 'D': _input.pushBuffer(Key(Key::KEY_HOME)); break;
-									case 'C': _input.pushBuffer(Key(Key::KEY_END)); break;
-								}
-						} else {
-							switch (c) {
-								case 'A': _input.pushBuffer(Key(Key::KEY_UP)); break;
-								case 'B': _input.pushBuffer(Key(Key::KEY_DOWN)); break;
-								case 'D': _input.pushBuffer(Key(Key::KEY_LEFT)); break;
-								case 'C': _input.pushBuffer(Key(Key::KEY_RIGHT)); break;
-								case 'Z': _input.pushBuffer(Key(Key::KEY_TAB_BACK)); break;
-							}
-						}
-					}
+// Turns what InputParser reports into keys on a KeyQueue. Text is split
+// into graphemes, pastes are collected into PASTE keys and mouse motion is
+// coalesced. Input feeds it from the terminal.
+class KeyBuilder {
+	// Pastes larger than this are delivered as several PASTE keys.
+	static const size_t PASTE_CHUNK_SIZE = 256 * 1024;
+	// Paste chunks that can be queued before the reader waits for the app.
+	static const size_t PASTE_BUFFERS = 4;
+	// Graphemes longer than this, runs of combining marks far beyond what
+	// any script uses, are split over several keys.
+	static const size_t MAX_GRAPHEME_SIZE = 256;
+
+	struct PasteBuffer {
+		std::string data;
+		size_t position = 0;
+		bool queued = false;
+	};
+
+	public:
+		KeyBuilder() {
+			_grapheme.reserve(MAX_GRAPHEME_SIZE);
+		}
+
+		KeyQueue& getBuffer() {
+			return _buffer;
+		}
+
+		// Keys queued from now on get time as the time they were read.
+		void readAt(Key::Clock::time_point time) {
+			_read_at = time;
+		}
 
-					reset();
-					return true;
+		// Queues the text and motion held back for the rest of a read.
+		void flush() {
+			flushText();
+			flushMotion();
+		}
+
+		void pushBuffer(const Key& key) {
+			flushText();
+			flushMotion();
+			queue(key);
+		}
+
+		void pushText(const char *data, size_t len) {
+			flushMotion();
+			_decoder.decode(data, len, [this](uint32_t codepoint) {
+				if (_breaker.next(codepoint)) {
+					queueGrapheme();
 				}
 
-				if (_escape_count && !_in_bracket && c == '[') {
-					_in_bracket = true;
-					return true;
+				appendText(codepoint);
+			});
+		}
+
+		// Pasted content is collected into PASTE keys of up to PASTE_CHUNK_SIZE
+		// bytes, the last one has the type PASTE_END. The data of a PASTE key,
+		// like that of a long DATA key, stays valid until the drain that
+		// delivered it returns.
+		void pushPaste(const char *data, size_t len) {
+			flushText();
+			flushMotion();
+
+			std::string &paste = pasteBuffer().data;
+			paste.append(data, len);
+
+			if (paste.size() >= PASTE_CHUNK_SIZE) {
+				const size_t split = utf8Boundary(paste);
+				queuePaste(Key::PASTE, split);
+				pasteBuffer().data.assign(paste, split, std::string::npos);
+			}
+		}
+
+		void endPaste() {
+			flushText();
+			flushMotion();
+			queuePaste(Key::PASTE_END, pasteBuffer().data.size());
+		}
+
+		// Motion reports within one read are coalesced, only the last position
+		// is queued.
+		void pushMouse(const Key& key) {
+			if (key.type != Key::MOUSE_MOVE) {
+				pushBuffer(key);
+				return;
+			}
+
+			flushText();
+			_motion = key;
+			_has_motion = true;
+		}
+
+	private:
+		KeyQueue _buffer;
+		Utf8Decoder _decoder;
+		Unicode::GraphemeBreaker _breaker;
+		std::string _grapheme;
+		std::array<PasteBuffer, PASTE_BUFFERS> _pastes;
+		size_t _paste_index = 0;
+		bool _pasting = false;
+		Key _motion;
+		bool _has_motion = false;
+		Key::Clock::time_point _read_at;
+
+		void appendText(uint32_t codepoint) {
+			char bytes[4];
+			const size_t len = utf8::append(codepoint, bytes) - bytes;
+
+			if (_grapheme.size() + len > MAX_GRAPHEME_SIZE) {
+				queueGrapheme();
+			}
+
+			_grapheme.append(bytes, len);
+		}
+
+		// Pushes the grapheme collected so far, combining marks that arrive
+		// in a later read will start a new key.
+		void flushText() {
+			queueGrapheme();
+			_breaker.reset();
+		}
+
+		// Graphemes that don't fit in a key, like ZWJ emoji sequences, are
+		// kept in a paste buffer and the key points there.
+		void queueGrapheme() {
+			if (_grapheme.empty()) {
+				return;
+			}
+
+			if (_grapheme.size() <= Key::TEXT_SIZE) {
+				queue(Key::text(_grapheme.data(), _grapheme.size()));
+			} else {
+				std::string &data = pasteBuffer().data;
+				data = _grapheme;
+				queueBuffered(Key::borrowed(Key::DATA, data.data(), data.size()));
+			}
+
+			_grapheme.clear();
+		}
+
+		void flushMotion() {
+			if (_has_motion) {
+				queue(_motion);
+				_has_motion = false;
+			}
+		}
+
+		bool queue(Key key) {
+			key.time = _read_at;
+			return _buffer.push(key);
+		}
+
+		// The buffer the current paste is collected in. Starting a new one
+		// waits until the app has consumed the key that last used it.
+		PasteBuffer& pasteBuffer() {
+			PasteBuffer &paste = _pastes[_paste_index];
+
+			if (!_pasting) {
+				while (!_buffer.closed() && paste.queued && !_buffer.consumed(paste.position)) {
+					std::this_thread::yield();
 				}
 
-				reset();
-				return false;
+				paste.data.clear();
+				paste.queued = false;
+				_pasting = true;
 			}
 
-			void reset() {
-				_escape_count = 0;
-				_in_bracket = false;
-				std::memset(_vt, 0, sizeof _vt);
+			return paste;
+		}
+
+		void queuePaste(Key::TYPE type, size_t len) {
+			queueBuffered(Key::paste(type, pasteBuffer().data.data(), len));
+		}
+
+		// Queues a key pointing into the current paste buffer, and moves on
+		// to the next buffer.
+		void queueBuffered(const Key &key) {
+			PasteBuffer &paste = pasteBuffer();
+			paste.position = _buffer.position();
+			paste.queued = queue(key);
+			_paste_index = (_paste_index + 1) % PASTE_BUFFERS;
+			_pasting = false;
+		}
+
+		// Length of str without a trailing incomplete UTF-8 sequence.
+		static size_t utf8Boundary(const std::string &str) {
+			size_t i = str.size();
+
+			while (i > 0 && str.size() - i < 4 && (str[i - 1] & 0xc0) == 0x80) {
+				i--;
 			}
 
-		private:
-			Input &_input;
-			uint8_t _escape_count;
-			bool _in_bracket;
-			char _vt[3];
-	};
+			if (i == 0) {
+				return str.size();
+			}
+
+			const uint8_t lead = str[i - 1];
+			const size_t needed = lead >= 0xf0 ? 4 : lead >= 0xe0 ? 3 : lead >= 0xc0 ? 2 : 1;
+
+			return str.size() - (i - 1) < needed ? i - 1 : str.size();
+		}
+};
+
+// Puts the terminal in raw mode with mouse and bracketed paste reporting,
+// and reads keys on a thread once run() is called.
+class Input : public KeyBuilder {
+	// Milliseconds to wait before treating a lone ESC as the escape key.
+	static const int ESCAPE_TIMEOUT = 25;
+	// Milliseconds between checks for the reader thread being stopped.
+	static const int STOP_TIMEOUT = 100;
 
 	public:
-		Input() : _th(nullptr) {
+		// Keys are read from the terminal even when stdin is a pipe, so
+		// stdin can carry data, e.g. video frames, to the application.
+		Input() : _fd(isatty(0) ? 0 : ::open("/dev/tty", O_RDONLY)), _th(nullptr) {
+			if (_fd < 0) {
+				_fd = 0;
+			}
+
 			_running = false;
-			tcgetattr(0, &this->_old_termios);
+			tcgetattr(_fd, &this->_old_termios);
 			termios settings = this->_old_termios;
 			settings.c_lflag &= ~ICANON; // disable buffered io
 			settings.c_lflag &= ~ECHO; // disable echo mode
-			tcsetattr(0, TCSANOW, &settings);
+			tcsetattr(_fd, TCSANOW, &settings);
 
 			std::ios_base::sync_with_stdio(false);
-			std::wcin.imbue(std::locale("en_US.UTF-8"));
-			std::wcout.imbue(std::locale("en_US.UTF-8"));
+			const std::locale locale = utf8Locale();
+			std::wcin.imbue(locale);
+			std::wcout.imbue(locale);
+
+			std::cout << "\033[?2004h\033[?1003h\033[?1006h" << std::flush;
 		}
 
 		~Input() {
-			tcsetattr(0, TCSANOW, &this->_old_termios);
+			// Nothing drains the keys anymore, so a reader waiting for a
+			// paste buffer to be consumed has to give up.
+			_running = false;
+			getBuffer().close();
 
-			if (_th == nullptr) {
-				_running = false;
+			if (_th != nullptr) {
+				_th->join();
+				delete _th;
+			}
+
+			std::cout << "\033[?1006l\033[?1003l\033[?2004l" << std::flush;
+			tcsetattr(_fd, TCSANOW, &this->_old_termios);
+
+			if (_fd != 0) {
+				::close(_fd);
 			}
 		}
 
@@ -113,85 +321,50 @@ class Input {
 			_running = true;
 
 			_th = new std::thread([this]() {
-				std::string str;
-				str.reserve(128);
-
-				char buffer[32];
-				size_t buflen = 0;
-
-				InputState state(*this);
+				char buffer[4096];
+				InputParser<KeyBuilder> parser(*this);
 
 				while (_running) {
-					buflen = ::read(0, &buffer, sizeof buffer);
-
-					for (size_t i = 0; i < buflen; i++) {
-						char c = buffer[i];
-
-						if (handleAscii(c)) {
-							continue;
+					if (!waitForInput(parser.pending() ? ESCAPE_TIMEOUT : STOP_TIMEOUT)) {
+						if (parser.pending()) {
+							parser.timeout();
 						}
 
-						if (state.handle(buffer + i, buflen - i)) {
-							continue;
-						}
-
-						state.reset();
-
-						str += c;
-
-						if (!utfstring::is_valid(str)) {
-							continue;
-						}
+						continue;
+					}
 
-						for (utfstring &ch : utfstring(str).chars()) {
-							pushBuffer(Key(ch.str()));
-						}
+					const ssize_t buflen = ::read(_fd, &buffer, sizeof buffer);
+					readAt(Key::Clock::now());
 
-						str = "";
+					if (buflen > 0) {
+						parser.feed(buffer, buflen);
+						flush();
 					}
 				}
 			});
 		}
 
-		std::list<Key> getBuffer() {
-			std::lock_guard<std::mutex> guard(_buffer_mutex);
-			std::list<Key> buffer = _buffer;
-			_buffer.clear();
-			return buffer;
-		}
-
-		void pushBuffer(Key key) {
-			std::lock_guard<std::mutex> guard(_buffer_mutex);
-			_buffer.push_back(key);
-		}
-
 	private:
+		int _fd;
 		termios _old_termios;
-		std::list<Key> _buffer;
-		std::mutex _buffer_mutex;
 		std::thread *_th;
-		bool _running;
-
-		bool handleAscii(const char c) {
-			switch (c) {
-				case 0x7f:
-						pushBuffer(Key(Key::KEY_BACKSPACE));
-						return true;
-				case 0x0a:
-						pushBuffer(Key(Key::KEY_RETURN));
-						return true;
-				case 0x09:
-						pushBuffer(Key(Key::KEY_TAB));
-						return true;
-				case 0x18:
-						pushBuffer(Key(Key::KEY_CANCEL));
-						return true;
-				case 0x0c:
-						pushBuffer(Key(Key::KEY_REDRAW));
-						return true;
-				default:
-						return false;
+		std::atomic<bool> _running;
+
+		// The first UTF-8 locale there is, or the classic one.
+		static std::locale utf8Locale() {
+			for (const char* name : {"en_US.UTF-8", "C.UTF-8", ""}) {
+				try {
+					return std::locale(name);
+				} catch (const std::runtime_error&) {
+				}
 			}
+
+			return std::locale::classic();
+		}
+
+		bool waitForInput(int timeout) const {
+			pollfd fd = {_fd, POLLIN, 0};
+			return ::poll(&fd, 1, timeout) > 0;
 		}
 };
 };
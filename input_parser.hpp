@@ -0,0 +1,530 @@
+#ifndef INPUT_PARSER_HPP
+#define INPUT_PARSER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "key.hpp"
+
+namespace Blurses {
+// Table driven parser for terminal input. Bytes can be fed in arbitrary
+// chunks, an unfinished escape sequence is kept until the next call.
+//
+// Sink must provide:
+//   void pushBuffer(const Key& key);
+//   void pushText(const char *data, size_t len);
+//   void pushPaste(const char *data, size_t len);
+//   void endPaste();
+//   void pushMouse(const Key& key);
+template <typename Sink>
+class InputParser {
+	enum STATE {
+		GROUND,
+		ESCAPE,
+		CSI,
+		SS3,
+		PASTE,
+		STATE_COUNT,
+	};
+
+	enum CLASS {
+		C_CONTROL,
+		C_ESCAPE,
+		C_DIGIT,
+		C_SEPARATOR,
+		C_PRIVATE,
+		C_CSI,
+		C_SS3,
+		C_FINAL,
+		C_INTERMEDIATE,
+		C_HIGH,
+		CLASS_COUNT,
+	};
+
+	enum ACTION {
+		A_NONE,
+		A_PRINT,
+		A_CONTROL,
+		A_ENTER_ESCAPE,
+		A_ALT_PREFIX,
+		A_ALT_PRINT,
+		A_ALT_CONTROL,
+		A_ESCAPE_REPLAY,
+		A_ENTER_SEQUENCE,
+		A_PARAM,
+		A_SEPARATOR,
+		A_PRIVATE,
+		A_CSI_DISPATCH,
+		A_SS3_DISPATCH,
+		A_ABORT,
+	};
+
+	struct Transition {
+		uint8_t action;
+		uint8_t next;
+	};
+
+	static const size_t MAX_PARAMS = 4;
+
+	public:
+		InputParser(Sink& sink)
+			: _sink(sink)
+			, _classes(classes()) {
+			reset();
+		}
+
+		void feed(const char *data, size_t len) {
+			size_t i = 0;
+
+			while (i < len) {
+				const uint8_t c = data[i];
+
+				if (_state == PASTE) {
+					i += feedPaste(data + i, len - i);
+					continue;
+				}
+
+				if (_state == GROUND && isText(c)) {
+					// Hand whole runs of text to the sink instead of byte by byte.
+					size_t end = i + 1;
+
+					while (end < len && isText(data[end])) {
+						end++;
+					}
+
+					_sink.pushText(data + i, end - i);
+					i = end;
+					continue;
+				}
+
+				const Transition &t = transitions()[_state][_classes[c]];
+
+				_state = t.next;
+
+				if (!run(static_cast<ACTION>(t.action), c)) {
+					continue;
+				}
+
+				i++;
+			}
+		}
+
+		// True while an escape sequence is incomplete, the caller should call
+		// timeout() if no more input arrives shortly.
+		bool pending() const {
+			return _state == ESCAPE || _state == CSI || _state == SS3;
+		}
+
+		// Resolves an incomplete sequence, a lone ESC becomes KEY_ESCAPE.
+		void timeout() {
+			switch (_state) {
+				case ESCAPE:
+					_sink.pushBuffer(Key(Key::KEY_ESCAPE, _modifiers));
+					break;
+				case CSI:
+					if (_param_count == 0 && _private == 0) {
+						_sink.pushBuffer(Key::text("[", 1, _modifiers | Key::MOD_ALT));
+					}
+					break;
+				case SS3:
+					if (_param_count == 0) {
+						_sink.pushBuffer(Key::text("O", 1, _modifiers | Key::MOD_ALT));
+					}
+					break;
+				default:
+					break;
+			}
+
+			reset();
+		}
+
+		void reset() {
+			_state = GROUND;
+			_modifiers = Key::MOD_NONE;
+			_paste_match = 0;
+			clearParams();
+		}
+
+	private:
+		Sink &_sink;
+		const std::array<uint8_t, 256> &_classes;
+		uint8_t _state;
+		uint8_t _modifiers;
+		char _private;
+		uint8_t _param_count;
+		uint16_t _params[MAX_PARAMS];
+		uint8_t _paste_match;
+
+		// Returns false when the byte has to be processed again in the new state.
+		bool run(ACTION action, uint8_t c) {
+			switch (action) {
+				case A_NONE:
+					break;
+				case A_PRINT: {
+					const char ch = c;
+					_sink.pushText(&ch, 1);
+					break;
+				}
+				case A_CONTROL:
+					pushControl(c, Key::MOD_NONE);
+					break;
+				case A_ENTER_ESCAPE:
+					_modifiers = Key::MOD_NONE;
+					break;
+				case A_ALT_PREFIX:
+					if (_modifiers & Key::MOD_ALT) {
+						_sink.pushBuffer(Key(Key::KEY_ESCAPE, Key::MOD_ALT));
+					}
+					_modifiers = Key::MOD_ALT;
+					break;
+				case A_ALT_PRINT:
+					pushChar(c, Key::MOD_ALT);
+					_modifiers = Key::MOD_NONE;
+					break;
+				case A_ALT_CONTROL:
+					pushControl(c, Key::MOD_ALT);
+					_modifiers = Key::MOD_NONE;
+					break;
+				case A_ESCAPE_REPLAY:
+					_sink.pushBuffer(Key(Key::KEY_ESCAPE, _modifiers));
+					_modifiers = Key::MOD_NONE;
+					return false;
+				case A_ENTER_SEQUENCE:
+					clearParams();
+					break;
+				case A_PARAM: {
+					if (_param_count == 0) {
+						_param_count = 1;
+					}
+
+					uint16_t &param = _params[_param_count - 1];
+
+					if (param < 1000) {
+						param = param * 10 + (c - '0');
+					}
+					break;
+				}
+				case A_SEPARATOR:
+					if (_param_count == 0) {
+						_param_count = 1;
+					}
+
+					if (_param_count < MAX_PARAMS) {
+						_params[_param_count++] = 0;
+					}
+					break;
+				case A_PRIVATE:
+					_private = c;
+					break;
+				case A_CSI_DISPATCH:
+					dispatchCsi(c);
+					_modifiers = Key::MOD_NONE;
+					break;
+				case A_SS3_DISPATCH:
+					dispatchSs3(c);
+					_modifiers = Key::MOD_NONE;
+					break;
+				case A_ABORT:
+					_modifiers = Key::MOD_NONE;
+					return false;
+			}
+
+			return true;
+		}
+
+		// Passes bracketed paste content through untouched until "\e[201~",
+		// which may itself be split across reads. Returns the bytes consumed.
+		size_t feedPaste(const char *data, size_t len) {
+			static const char end_marker[] = "\033[201~";
+			size_t i = 0;
+
+			while (i < len) {
+				if (_paste_match == 0) {
+					const char *esc = static_cast<const char*>(std::memchr(data + i, 0x1b, len - i));
+					const size_t end = esc ? esc - data : len;
+
+					if (end > i) {
+						_sink.pushPaste(data + i, end - i);
+					}
+
+					if (end == len) {
+						return len;
+					}
+
+					_paste_match = 1;
+					i = end + 1;
+					continue;
+				}
+
+				if (data[i] == end_marker[_paste_match]) {
+					i++;
+
+					if (++_paste_match == sizeof end_marker - 1) {
+						_paste_match = 0;
+						_state = GROUND;
+						_sink.endPaste();
+						return i;
+					}
+
+					continue;
+				}
+
+				// Not the end marker after all, the matched bytes were content.
+				_sink.pushPaste(end_marker, _paste_match);
+				_paste_match = 0;
+			}
+
+			return i;
+		}
+
+		bool isText(uint8_t c) const {
+			return _classes[c] != C_CONTROL && _classes[c] != C_ESCAPE;
+		}
+
+		void clearParams() {
+			_private = 0;
+			_param_count = 0;
+			std::fill(_params, _params + MAX_PARAMS, 0);
+		}
+
+		uint16_t param(uint8_t index, uint16_t fallback) const {
+			if (index >= _param_count || _params[index] == 0) {
+				return fallback;
+			}
+
+			return _params[index];
+		}
+
+		uint8_t modifiers(uint8_t index) const {
+			return _modifiers | ((param(index, 1) - 1) & 0x0f);
+		}
+
+		void pushChar(uint8_t c, uint8_t modifiers) {
+			const char ch = c;
+			_sink.pushBuffer(Key::text(&ch, 1, modifiers));
+		}
+
+		void pushControl(uint8_t c, uint8_t modifiers) {
+			switch (c) {
+				case 0x7f: _sink.pushBuffer(Key(Key::KEY_BACKSPACE, modifiers)); break;
+				case 0x0a: _sink.pushBuffer(Key(Key::KEY_RETURN, modifiers)); break;
+				case 0x09: _sink.pushBuffer(Key(Key::KEY_TAB, modifiers)); break;
+				case 0x18: _sink.pushBuffer(Key(Key::KEY_CANCEL, modifiers)); break;
+				case 0x0c: _sink.pushBuffer(Key(Key::KEY_REDRAW, modifiers)); break;
+				default: pushChar(c, modifiers); break;
+			}
+		}
+
+		// Final bytes shared by CSI and SS3, e.g. "\e[A", "\e[1;5A" and "\eOA".
+		bool pushFinal(uint8_t c, uint8_t modifiers) {
+			switch (c) {
+				case 'A': _sink.pushBuffer(Key(Key::KEY_UP, modifiers)); return true;
+				case 'B': _sink.pushBuffer(Key(Key::KEY_DOWN, modifiers)); return true;
+				case 'C': _sink.pushBuffer(Key(Key::KEY_RIGHT, modifiers)); return true;
+				case 'D': _sink.pushBuffer(Key(Key::KEY_LEFT, modifiers)); return true;
+				case 'H': _sink.pushBuffer(Key(Key::KEY_HOME, modifiers)); return true;
+				case 'F': _sink.pushBuffer(Key(Key::KEY_END, modifiers)); return true;
+				case 'P': _sink.pushBuffer(Key(Key::KEY_F1, modifiers)); return true;
+				case 'Q': _sink.pushBuffer(Key(Key::KEY_F2, modifiers)); return true;
+				case 'R': _sink.pushBuffer(Key(Key::KEY_F3, modifiers)); return true;
+				case 'S': _sink.pushBuffer(Key(Key::KEY_F4, modifiers)); return true;
+				default: return false;
+			}
+		}
+
+		void dispatchCsi(uint8_t c) {
+			if (_private == '<' && (c == 'M' || c == 'm')) {
+				dispatchMouse(c == 'm');
+				return;
+			}
+
+			if (_private != 0) {
+				return;
+			}
+
+			if (c == '~' && param(0, 0) == 200) {
+				_state = PASTE;
+				_paste_match = 0;
+				return;
+			}
+
+			if (c == '~') {
+				dispatchTilde(param(0, 0), modifiers(1));
+				return;
+			}
+
+			if (c == 'Z') {
+				_sink.pushBuffer(Key(Key::KEY_TAB_BACK, modifiers(1)));
+				return;
+			}
+
+			pushFinal(c, modifiers(1));
+		}
+
+		void dispatchSs3(uint8_t c) {
+			pushFinal(c, modifiers(_param_count > 0 ? _param_count - 1 : 0));
+		}
+
+		// SGR (1006) mouse report, "\e[<b;x;yM" or "\e[<b;x;ym" on release.
+		void dispatchMouse(bool release) {
+			if (_param_count < 3) {
+				return;
+			}
+
+			const uint16_t code = _params[0];
+			const uint16_t x = param(1, 1) - 1;
+			const uint16_t y = param(2, 1) - 1;
+
+			uint8_t modifiers = _modifiers;
+			if (code & 4) { modifiers |= Key::MOD_SHIFT; }
+			if (code & 8) { modifiers |= Key::MOD_ALT; }
+			if (code & 16) { modifiers |= Key::MOD_CTRL; }
+
+			const Key::BUTTON button = static_cast<Key::BUTTON>(code & 3);
+			Key::TYPE type;
+
+			if (code & 64) {
+				// Wheel buttons 4 to 7: up, down, left, right.
+				static const Key::TYPE wheel[4] = {
+					Key::MOUSE_SCROLL_UP,
+					Key::MOUSE_SCROLL_DOWN,
+					Key::MOUSE_SCROLL_LEFT,
+					Key::MOUSE_SCROLL_RIGHT
+				};
+
+				type = wheel[code & 3];
+			} else if (code & 32) {
+				type = Key::MOUSE_MOVE;
+			} else {
+				type = release ? Key::MOUSE_UP : Key::MOUSE_DOWN;
+			}
+
+			_sink.pushMouse(Key::mouse(type, x, y, button, modifiers));
+		}
+
+		void dispatchTilde(uint16_t code, uint8_t modifiers) {
+			Key::TYPE type;
+
+			switch (code) {
+				case 1: case 7: type = Key::KEY_HOME; break;
+				case 2: type = Key::KEY_INSERT; break;
+				case 3: type = Key::KEY_DELETE; break;
+				case 4: case 8: type = Key::KEY_END; break;
+				case 5: type = Key::KEY_PAGE_UP; break;
+				case 6: type = Key::KEY_PAGE_DOWN; break;
+				case 11: type = Key::KEY_F1; break;
+				case 12: type = Key::KEY_F2; break;
+				case 13: type = Key::KEY_F3; break;
+				case 14: type = Key::KEY_F4; break;
+				case 15: type = Key::KEY_F5; break;
+				case 17: type = Key::KEY_F6; break;
+				case 18: type = Key::KEY_F7; break;
+				case 19: type = Key::KEY_F8; break;
+				case 20: type = Key::KEY_F9; break;
+				case 21: type = Key::KEY_F10; break;
+				case 23: type = Key::KEY_F11; break;
+				case 24: type = Key::KEY_F12; break;
+				default: return;
+			}
+
+			_sink.pushBuffer(Key(type, modifiers));
+		}
+
+		static const std::array<uint8_t, 256>& classes() {
+			static const std::array<uint8_t, 256> table = buildClasses();
+			return table;
+		}
+
+		static std::array<uint8_t, 256> buildClasses() {
+			std::array<uint8_t, 256> table;
+
+			for (size_t c = 0; c < 256; c++) {
+				if (c == 0x1b) {
+					table[c] = C_ESCAPE;
+				} else if (c < 0x20 || c == 0x7f) {
+					table[c] = C_CONTROL;
+				} else if (c >= '0' && c <= '9') {
+					table[c] = C_DIGIT;
+				} else if (c == ';' || c == ':') {
+					table[c] = C_SEPARATOR;
+				} else if (c >= '<' && c <= '?') {
+					table[c] = C_PRIVATE;
+				} else if (c == '[') {
+					table[c] = C_CSI;
+				} else if (c == 'O') {
+					table[c] = C_SS3;
+				} else if (c >= 0x40 && c <= 0x7e) {
+					table[c] = C_FINAL;
+				} else if (c < 0x80) {
+					table[c] = C_INTERMEDIATE;
+				} else {
+					table[c] = C_HIGH;
+				}
+			}
+
+			return table;
+		}
+
+		static const Transition (&transitions())[STATE_COUNT][CLASS_COUNT] {
+			static const Transition table[STATE_COUNT][CLASS_COUNT] = {
+				// GROUND
+				{
+					{A_CONTROL, GROUND},           // C_CONTROL
+					{A_ENTER_ESCAPE, ESCAPE},      // C_ESCAPE
+					{A_PRINT, GROUND},             // C_DIGIT
+					{A_PRINT, GROUND},             // C_SEPARATOR
+					{A_PRINT, GROUND},             // C_PRIVATE
+					{A_PRINT, GROUND},             // C_CSI
+					{A_PRINT, GROUND},             // C_SS3
+					{A_PRINT, GROUND},             // C_FINAL
+					{A_PRINT, GROUND},             // C_INTERMEDIATE
+					{A_PRINT, GROUND},             // C_HIGH
+				},
+				// ESCAPE
+				{
+					{A_ALT_CONTROL, GROUND},       // C_CONTROL
+					{A_ALT_PREFIX, ESCAPE},        // C_ESCAPE
+					{A_ALT_PRINT, GROUND},         // C_DIGIT
+					{A_ALT_PRINT, GROUND},         // C_SEPARATOR
+					{A_ALT_PRINT, GROUND},         // C_PRIVATE
+					{A_ENTER_SEQUENCE, CSI},       // C_CSI
+					{A_ENTER_SEQUENCE, SS3},       // C_SS3
+					{A_ALT_PRINT, GROUND},         // C_FINAL
+					{A_ALT_PRINT, GROUND},         // C_INTERMEDIATE
+					{A_ESCAPE_REPLAY, GROUND},     // C_HIGH
+				},
+				// CSI
+				{
+					{A_ABORT, GROUND},             // C_CONTROL
+					{A_ABORT, GROUND},             // C_ESCAPE
+					{A_PARAM, CSI},                // C_DIGIT
+					{A_SEPARATOR, CSI},            // C_SEPARATOR
+					{A_PRIVATE, CSI},              // C_PRIVATE
+					{A_CSI_DISPATCH, GROUND},      // C_CSI
+					{A_CSI_DISPATCH, GROUND},      // C_SS3
+					{A_CSI_DISPATCH, GROUND},      // C_FINAL
+					{A_NONE, CSI},                 // C_INTERMEDIATE
+					{A_ABORT, GROUND},             // C_HIGH
+				},
+				// SS3
+				{
+					{A_ABORT, GROUND},             // C_CONTROL
+					{A_ABORT, GROUND},             // C_ESCAPE
+					{A_PARAM, SS3},                // C_DIGIT
+					{A_SEPARATOR, SS3},            // C_SEPARATOR
+					{A_ABORT, GROUND},             // C_PRIVATE
+					{A_SS3_DISPATCH, GROUND},      // C_CSI
+					{A_SS3_DISPATCH, GROUND},      // C_SS3
+					{A_SS3_DISPATCH, GROUND},      // C_FINAL
+					{A_ABORT, GROUND},             // C_INTERMEDIATE
+					{A_ABORT, GROUND},             // C_HIGH
+				},
+			};
+
+			return table;
+		}
+};
+};
+
+#endif
@@ -2,10 +2,16 @@
 #define KEY_HPP
 
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
 
 namespace Blurses {
+// Input event. Text is stored inline so keys can be copied around without
+// allocating. PASTE keys, and DATA keys holding a grapheme longer than
+// TEXT_SIZE, point into a buffer owned by Input.
 struct Key {
-	enum TYPE {
+	enum TYPE : uint8_t {
 		DATA,
 		KEY_UP,
 		KEY_DOWN,
@@ -21,13 +27,134 @@ struct Key {
 		KEY_TAB_BACK,
 		KEY_END,
 		KEY_HOME,
+		KEY_INSERT,
+		KEY_PAGE_UP,
+		KEY_PAGE_DOWN,
+		KEY_F1,
+		KEY_F2,
+		KEY_F3,
+		KEY_F4,
+		KEY_F5,
+		KEY_F6,
+		KEY_F7,
+		KEY_F8,
+		KEY_F9,
+		KEY_F10,
+		KEY_F11,
+		KEY_F12,
+		PASTE,
+		PASTE_END,
+		MOUSE_DOWN,
+		MOUSE_UP,
+		MOUSE_MOVE,
+		MOUSE_SCROLL_UP,
+		MOUSE_SCROLL_DOWN,
+		MOUSE_SCROLL_LEFT,
+		MOUSE_SCROLL_RIGHT,
 	};
 
-	Key(Key::TYPE type) : type(type) {}
-	Key(std::string str) : type(Key::DATA), data(str) {}
+	enum BUTTON : uint8_t {
+		BUTTON_LEFT,
+		BUTTON_MIDDLE,
+		BUTTON_RIGHT,
+		BUTTON_NONE,
+	};
+
+	// Same bit layout as the xterm modifier parameter minus one.
+	enum MODIFIER {
+		MOD_NONE = 0,
+		MOD_SHIFT = 1,
+		MOD_ALT = 2,
+		MOD_CTRL = 4,
+		MOD_META = 8,
+	};
+
+	// Longest grapheme stored inline in a DATA key.
+	static const size_t TEXT_SIZE = 16;
+
+	typedef std::chrono::steady_clock Clock;
+
+	Key() : Key(Key::DATA) {}
+	Key(Key::TYPE type, uint8_t modifiers = MOD_NONE)
+		: type(type)
+		, modifiers(modifiers)
+		, button(BUTTON_NONE)
+		, x(0)
+		, y(0)
+		, _length(0) {}
+
+	// Copies at most TEXT_SIZE bytes, use borrowed() for longer text.
+	static Key text(const char *data, size_t len, uint8_t modifiers = MOD_NONE) {
+		Key key(Key::DATA, modifiers);
+		key._length = len < TEXT_SIZE ? len : TEXT_SIZE;
+		std::memcpy(key._text, data, key._length);
+		return key;
+	}
+
+	// Refers to data instead of copying it, the caller keeps it alive.
+	static Key borrowed(Key::TYPE type, const char *data, size_t len) {
+		Key key(type);
+		key._length = BORROWED;
+		key._borrowed.data = data;
+		key._borrowed.size = len;
+		return key;
+	}
+
+	static Key paste(Key::TYPE type, const char *data, size_t len) {
+		return borrowed(type, data, len);
+	}
+
+	static Key mouse(Key::TYPE type, uint16_t x, uint16_t y, Key::BUTTON button, uint8_t modifiers = MOD_NONE) {
+		Key key(type, modifiers);
+		key.x = x;
+		key.y = y;
+		key.button = button;
+		return key;
+	}
+
+	bool isMouse() const {
+		return type >= MOUSE_DOWN && type <= MOUSE_SCROLL_RIGHT;
+	}
+
+	bool isPaste() const {
+		return type == PASTE || type == PASTE_END;
+	}
+
+	bool hasModifier(MODIFIER modifier) const {
+		return (modifiers & modifier) != 0;
+	}
+
+	const char* data() const {
+		return _length == BORROWED ? _borrowed.data : _text;
+	}
+
+	size_t size() const {
+		return _length == BORROWED ? _borrowed.size : _length;
+	}
+
+	std::string str() const {
+		return std::string(data(), size());
+	}
 
 	Key::TYPE type;
-	std::string data;
+	uint8_t modifiers;
+	Key::BUTTON button;
+	uint16_t x;
+	uint16_t y;
+	Clock::time_point time;
+
+	private:
+		static const uint8_t BORROWED = 0xff;
+
+		uint8_t _length;
+
+		union {
+			char _text[TEXT_SIZE];
+			struct {
+				const char *data;
+				size_t size;
+			} _borrowed;
+		};
 };
 };
 
@@ -0,0 +1,97 @@
+#ifndef LATENCY_HPP
+#define LATENCY_HPP
+
+#include <array>
+#include <algorithm>
+#include <chrono>
+
+namespace Blurses {
+// Input-to-display latency. Keys are reported as they are delivered to the
+// application and measured against the next flush of the display.
+class Latency {
+	static const size_t WINDOW_SIZE = 1024;
+
+	public:
+		typedef std::chrono::steady_clock Clock;
+		typedef std::chrono::microseconds Duration;
+
+		struct Stats {
+			size_t count;
+			Duration min;
+			Duration median;
+			Duration p99;
+		};
+
+		Latency() : _pending(0), _window_count(0), _window_pos(0), _frame({0, Duration(0), Duration(0), Duration(0)}) { }
+
+		void delivered(Clock::time_point readAt) {
+			if (_pending < _pending_at.size()) {
+				_pending_at[_pending++] = readAt;
+			}
+		}
+
+		void flushed(Clock::time_point now = Clock::now()) {
+			if (_pending == 0) {
+				_frame = {0, Duration(0), Duration(0), Duration(0)};
+				return;
+			}
+
+			for (size_t i = 0; i < _pending; i++) {
+				const Duration latency = std::chrono::duration_cast<Duration>(now - _pending_at[i]);
+				_scratch[i] = latency;
+				_window[_window_pos] = latency;
+				_window_pos = (_window_pos + 1) % WINDOW_SIZE;
+
+				if (_window_count < WINDOW_SIZE) {
+					_window_count++;
+				}
+			}
+
+			_frame = stats(_pending);
+			_pending = 0;
+		}
+
+		// Keys shown by the last flush.
+		const Stats& frame() const {
+			return _frame;
+		}
+
+		// The last WINDOW_SIZE keys.
+		Stats window() {
+			std::copy(_window.begin(), _window.begin() + _window_count, _scratch.begin());
+			return stats(_window_count);
+		}
+
+	private:
+		std::array<Clock::time_point, WINDOW_SIZE> _pending_at;
+		std::array<Duration, WINDOW_SIZE> _window;
+		std::array<Duration, WINDOW_SIZE> _scratch;
+		size_t _pending;
+		size_t _window_count;
+		size_t _window_pos;
+		Stats _frame;
+
+		Stats stats(size_t count) {
+			if (count == 0) {
+				return {0, Duration(0), Duration(0), Duration(0)};
+			}
+
+			auto begin = _scratch.begin();
+			auto end = begin + count;
+			Stats result;
+			result.count = count;
+			result.min = *std::min_element(begin, end);
+
+			std::nth_element(begin, begin + count / 2, end);
+			result.median = begin[count / 2];
+
+			const size_t p99 = std::min(count - 1, (count * 99) / 100);
+			std::nth_element(begin, begin + p99, end);
+			result.p99 = begin[p99];
+
+			return result;
+		}
+};
+};
+
+#endif
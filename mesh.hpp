@@ -0,0 +1,82 @@
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Blurses {
+// Indexed triangles. Vertex attributes are kept in one array per component
+// so the renderer can transform all positions in a single tight loop.
+class Mesh {
+	public:
+		void reserve(size_t vertices, size_t triangles) {
+			_x.reserve(vertices);
+			_y.reserve(vertices);
+			_z.reserve(vertices);
+			_r.reserve(vertices);
+			_g.reserve(vertices);
+			_b.reserve(vertices);
+			_nx.reserve(vertices);
+			_ny.reserve(vertices);
+			_nz.reserve(vertices);
+			_indices.reserve(triangles * 3);
+		}
+
+		// Returns the index of the new vertex. Color components are 0 to 1.
+		uint32_t addVertex(const glm::vec3 &position, const glm::vec3 &color, const glm::vec3 &normal = glm::vec3(0.0f)) {
+			_x.push_back(position.x);
+			_y.push_back(position.y);
+			_z.push_back(position.z);
+			_r.push_back(color.r);
+			_g.push_back(color.g);
+			_b.push_back(color.b);
+			_nx.push_back(normal.x);
+			_ny.push_back(normal.y);
+			_nz.push_back(normal.z);
+			return _x.size() - 1;
+		}
+
+		Mesh& addTriangle(uint32_t a, uint32_t b, uint32_t c) {
+			if (a >= _x.size() || b >= _x.size() || c >= _x.size()) {
+				throw "Vertex index out of range";
+			}
+
+			_indices.push_back(a);
+			_indices.push_back(b);
+			_indices.push_back(c);
+			return *this;
+		}
+
+		void clear() {
+			_x.clear();
+			_y.clear();
+			_z.clear();
+			_r.clear();
+			_g.clear();
+			_b.clear();
+			_nx.clear();
+			_ny.clear();
+			_nz.clear();
+			_indices.clear();
+		}
+
+		size_t vertexCount() const {
+			return _x.size();
+		}
+
+		size_t triangleCount() const {
+			return _indices.size() / 3;
+		}
+
+	private:
+		friend class Renderer;
+
+		std::vector<float> _x, _y, _z;
+		std::vector<float> _r, _g, _b;
+		std::vector<float> _nx, _ny, _nz;
+		std::vector<uint32_t> _indices;
+};
+};
+
+#endif
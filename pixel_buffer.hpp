@@ -0,0 +1,246 @@
+#ifndef PIXEL_BUFFER_HPP
+#define PIXEL_BUFFER_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "display.hpp"
+#include "utfstring.hpp"
+
+namespace Blurses {
+// Block glyphs by mask of the pixels drawn in the foreground color, bit 0
+// being the top left, then row by row.
+const char* const QUADRANT_GLYPHS[16] = {
+	" ", "▘", "▝", "▀", "▖", "▌", "▞", "▛",
+	"▗", "▚", "▐", "▜", "▄", "▙", "▟", "█"
+};
+
+// RGB pixels drawn to the terminal with several pixels per cell. Each cell
+// gets the two colors that fit its pixels best as foreground and
+// background, and the block glyph that matches their layout.
+class PixelBuffer {
+	public:
+		enum ENCODING {
+			HALF_BLOCK, // 1x2
+			QUADRANT,   // 2x2
+			SEXTANT     // 2x3
+		};
+
+		PixelBuffer(uint16_t width, uint16_t height)
+			: _width(width)
+			, _height(height) {
+			_r.resize(_width * _height, 0);
+			_g.resize(_width * _height, 0);
+			_b.resize(_width * _height, 0);
+		}
+
+		PixelBuffer& set(uint16_t x, uint16_t y, const Color &color) {
+			if (x >= _width) { return *this; }
+			if (y >= _height) { return *this; }
+
+			const size_t i = y * _width + x;
+			_r[i] = color.r;
+			_g[i] = color.g;
+			_b[i] = color.b;
+			return *this;
+		}
+
+		Color get(uint16_t x, uint16_t y) const {
+			const size_t i = y * _width + x;
+			return Color(_r[i], _g[i], _b[i]);
+		}
+
+		void clear(const Color &color = 0x000000) {
+			std::fill(_r.begin(), _r.end(), color.r);
+			std::fill(_g.begin(), _g.end(), color.g);
+			std::fill(_b.begin(), _b.end(), color.b);
+		}
+
+		uint16_t width() const {
+			return _width;
+		}
+
+		uint16_t height() const {
+			return _height;
+		}
+
+		static uint8_t cellWidth(ENCODING encoding) {
+			return encoding == HALF_BLOCK ? 1 : 2;
+		}
+
+		static uint8_t cellHeight(ENCODING encoding) {
+			return encoding == SEXTANT ? 3 : 2;
+		}
+
+		// Pixel size that fills the given number of cells.
+		static uint16_t width(ENCODING encoding, uint16_t columns) {
+			return columns * cellWidth(encoding);
+		}
+
+		static uint16_t height(ENCODING encoding, uint16_t rows) {
+			return rows * cellHeight(encoding);
+		}
+
+		// Encodes the whole buffer in one pass, with its top left cell at x, y.
+		void draw(Display &display, uint16_t x, uint16_t y, ENCODING encoding) const {
+			const uint8_t cw = cellWidth(encoding);
+			const uint8_t ch = cellHeight(encoding);
+			const uint16_t columns = (_width + cw - 1) / cw;
+			const uint16_t rows = (_height + ch - 1) / ch;
+			Cell cell;
+
+			if (columns == 0) {
+				return;
+			}
+
+			for (uint16_t row = 0; row < rows && y + row < display.height(); row++) {
+				Buffer::Span span = display.span(y + row, x, x + columns - 1);
+
+				for (uint16_t column = 0; column < span.size(); column++) {
+					Fit fit;
+					encode(column * cw, row * ch, cw, ch, fit);
+
+					cell.fg = display.color(Color(fit.fg[0], fit.fg[1], fit.fg[2]));
+					cell.bg = display.color(Color(fit.bg[0], fit.bg[1], fit.bg[2]));
+					cell.data = glyph(encoding, fit.mask);
+					span.set(column, cell);
+				}
+			}
+		}
+
+	private:
+		struct Fit {
+			uint8_t mask;
+			uint8_t fg[3];
+			uint8_t bg[3];
+		};
+
+		const uint16_t _width;
+		const uint16_t _height;
+		// Channels are kept in separate planes so the per-cell sums below
+		// are plain loops over bytes.
+		std::vector<uint8_t> _r;
+		std::vector<uint8_t> _g;
+		std::vector<uint8_t> _b;
+
+		// Finds the split of the cell's pixels into two groups with the least
+		// squared error around each group's mean. That is the split with the
+		// largest sum(group)^2 / size(group) over both groups, so only the
+		// sums are needed. The last pixel is always in the background group,
+		// which leaves 2^(n-1) splits to try.
+		void encode(uint16_t px, uint16_t py, uint8_t cw, uint8_t ch, Fit &fit) const {
+			const uint8_t n = cw * ch;
+			int32_t pixels[3][6];
+
+			for (uint8_t i = 0; i < n; i++) {
+				const uint16_t x = std::min<uint16_t>(px + i % cw, _width - 1);
+				const uint16_t y = std::min<uint16_t>(py + i / cw, _height - 1);
+				const size_t offset = y * _width + x;
+				pixels[0][i] = _r[offset];
+				pixels[1][i] = _g[offset];
+				pixels[2][i] = _b[offset];
+			}
+
+			int32_t total[3] = {0, 0, 0};
+
+			for (uint8_t c = 0; c < 3; c++) {
+				for (uint8_t i = 0; i < n; i++) {
+					total[c] += pixels[c][i];
+				}
+			}
+
+			const uint8_t splits = 1 << (n - 1);
+			float best_score = -1;
+			uint8_t best = 0;
+
+			for (uint8_t mask = 0; mask < splits; mask++) {
+				int32_t sum[3] = {0, 0, 0};
+				int32_t count = 0;
+
+				for (uint8_t i = 0; i < n; i++) {
+					const int32_t in = (mask >> i) & 1;
+					count += in;
+					sum[0] += pixels[0][i] * in;
+					sum[1] += pixels[1][i] * in;
+					sum[2] += pixels[2][i] * in;
+				}
+
+				float score = 0;
+
+				for (uint8_t c = 0; c < 3; c++) {
+					const float rest = total[c] - sum[c];
+					score += rest * rest / (n - count);
+
+					if (count > 0) {
+						score += float(sum[c]) * sum[c] / count;
+					}
+				}
+
+				if (score > best_score) {
+					best_score = score;
+					best = mask;
+				}
+			}
+
+			int32_t count = 0;
+			int32_t sum[3] = {0, 0, 0};
+
+			for (uint8_t i = 0; i < n; i++) {
+				if ((best >> i) & 1) {
+					count++;
+
+					for (uint8_t c = 0; c < 3; c++) {
+						sum[c] += pixels[c][i];
+					}
+				}
+			}
+
+			for (uint8_t c = 0; c < 3; c++) {
+				fit.bg[c] = (total[c] - sum[c]) / (n - count);
+				fit.fg[c] = count > 0 ? sum[c] / count : fit.bg[c];
+			}
+
+			fit.mask = best;
+		}
+
+		static const char* glyph(ENCODING encoding, uint8_t mask) {
+			switch (encoding) {
+				case HALF_BLOCK:
+					return mask ? "▀" : " ";
+				case QUADRANT:
+					return QUADRANT_GLYPHS[mask];
+				default:
+					return sextant(mask);
+			}
+		}
+
+		// Sextants are U+1FB00 onwards, leaving out the ones that already
+		// exist as space, left half, right half and full block.
+		static const char* sextant(uint8_t mask) {
+			static const SextantGlyphs glyphs;
+			return glyphs.data[mask].c_str();
+		}
+
+		struct SextantGlyphs {
+			std::string data[64];
+
+			SextantGlyphs() {
+				for (int mask = 0; mask < 64; mask++) {
+					if (mask == 0) {
+						data[mask] = " ";
+					} else if (mask == 21) {
+						data[mask] = "▌";
+					} else if (mask == 42) {
+						data[mask] = "▐";
+					} else if (mask == 63) {
+						data[mask] = "█";
+					} else {
+						data[mask] = utfstring::decode(0x1fb00 + mask - 1 - (mask > 21) - (mask > 42)).str();
+					}
+				}
+			}
+		};
+};
+};
+
+#endif
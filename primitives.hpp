@@ -6,89 +6,194 @@
 #include "buffer.hpp"
 #include "utfstring.hpp"
 #include "graphics.hpp"
+#include "text_cache.hpp"
 
 namespace Blurses {
 class Primitives {
 	public:
 		Primitives(Display& buffer) : _display(buffer) { }
 
-		void text(uint16_t x, uint16_t y, utfstring text, const CellAttributes &attrs) const {
-			if (y >= _display.height()) {
+		void text(int x, int y, const utfstring &text, const CellAttributes &attrs) const {
+			if (y < 0 || y >= _display.height()) {
 				return;
 			}
 
+			if (const TextCache::Entry *entry = _text_cache.get(text, attrs)) {
+				cachedText(x, y, *entry);
+				return;
+			}
+
+			this->text(x, y, text.graphemes(), attrs);
+		}
+
+		// Text starting left of the display is clipped at its left edge.
+		void text(int x, int y, const utfstring::grapheme_range &graphemes, const CellAttributes &attrs) const {
+			if (y < 0 || y >= _display.height()) {
+				return;
+			}
+
+			Buffer::Span span = _display.span(y, x, _display.width() - 1);
 			int i = 0;
 
-			for (utfstring ch : text.chars()) {
-				if (x + i >= _display.width()) {
+			for (const utfstring::grapheme &ch : graphemes) {
+				if (x + i + ch.width > _display.width()) {
 					return;
 				}
 
-				putchar(x + i, y, ch.str(), attrs);
-				i++;
+				if (x + i < 0) {
+					i += ch.width;
+					continue;
+				}
+
+				const uint16_t index = x + i - span.x();
+				Cell cell = span[index];
+				attrs.apply(cell);
+				cell.data.assign(ch.data, ch.size);
+				cell.width = ch.width;
+				span.set(index, cell);
+				i += ch.width;
 			}
 		}
 
-		void putchar(uint16_t x, uint16_t y, std::string ch, const CellAttributes &attrs) const {
-			if (x >= _display.width()) { return; }
-			if (y >= _display.height()) { return; }
+		// ch is one grapheme, as wide as its widest codepoint.
+		void putchar(int x, int y, const std::string &ch, const CellAttributes &attrs) const {
+			const char* curr = ch.data();
+			const char* end = curr + ch.size();
+			uint8_t width = 1;
+
+			while (curr != end) {
+				width = std::max(width, Unicode::width(utf8::next(curr, end)));
+			}
+
+			putchar(x, y, ch.data(), ch.size(), width > 1 ? 2 : 1, attrs);
+		}
+
+		void putchar(int x, int y, const char* data, size_t size, uint8_t width, const CellAttributes &attrs) const {
+			if (x < 0 || x >= _display.width()) { return; }
+			if (y < 0 || y >= _display.height()) { return; }
 
 			Cell cell = _display.get(x, y);
 			attrs.apply(cell);
-			cell.data = ch;
+			cell.data.assign(data, size);
+			cell.width = width;
 			set(x, y, cell);
 		}
 
-		void circle(uint16_t cx, uint16_t cy, float radius, const CellAttributes &attrs) const {
+		// Circles are squashed vertically to look round with cells about
+		// twice as tall as they are wide.
+		void circle(int cx, int cy, float radius, const CellAttributes &attrs) const {
+			ellipse(cx, cy, std::lround(radius), std::lround(radius * 0.5), attrs);
+		}
+
+		void filledCircle(int cx, int cy, float radius, const CellAttributes &attrs) const {
+			filledEllipse(cx, cy, std::lround(radius), std::lround(radius * 0.5), attrs);
+		}
+
+		void ellipse(int cx, int cy, int rx, int ry, const CellAttributes &attrs) const {
 			Cell cell(attrs.buildCell());
 
-			Graphics::circle(cx, cy, radius, 16, [&](uint16_t x, uint16_t y) {
+			Graphics::ellipse(cx, cy, rx, ry, [&](int x, int y) {
 				set(x, y, cell);
 			});
 		}
 
-		void rect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const CellAttributes &attrs) const {
+		void filledEllipse(int cx, int cy, int rx, int ry, const CellAttributes &attrs) const {
+			Cell cell(attrs.buildCell());
+
+			Graphics::filledEllipse(cx, cy, rx, ry, [&](int x0, int x1, int y) {
+				if (y < 0 || y >= _display.height()) {
+					return;
+				}
+
+				_display.span(y, x0, x1).fill(cell);
+			});
+		}
+
+		void rect(int x0, int y0, int x1, int y1, const CellAttributes &attrs) const {
 			Cell cell(attrs.buildCell());
 
 			if (x1 < x0) { std::swap(x0, x1); }
 			if (y1 < y0) { std::swap(y0, y1); }
 
-			for (uint16_t x = x0; x <= x1; x++) {
+			const int left = std::max(x0, 0);
+			const int right = std::min(x1, _display.width() - 1);
+			const int top = std::max(y0, 0);
+			const int bottom = std::min(y1, _display.height() - 1);
+
+			for (int x = left; x <= right; x++) {
 				set(x, y0, cell);
 				set(x, y1, cell);
 			}
 
-			for (uint16_t y = y0; y <= y1; y++) {
+			for (int y = top; y <= bottom; y++) {
 				set(x0, y, cell);
 				set(x1, y, cell);
 			}
 		}
 
-		void filledRect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const CellAttributes &attrs) const {
+		void filledRect(int x0, int y0, int x1, int y1, const CellAttributes &attrs) const {
 			Cell cell(attrs.buildCell());
 
 			if (x1 < x0) { std::swap(x0, x1); }
 			if (y1 < y0) { std::swap(y0, y1); }
 
-			for (uint16_t x = x0; x <= x1; x++) {
-				for (uint16_t y = y0; y <= y1; y++) {
-					set(x, y, cell);
-				}
+			y0 = std::max(y0, 0);
+			y1 = std::min(y1, _display.height() - 1);
+
+			for (int y = y0; y <= y1; y++) {
+				_display.span(y, x0, x1).fill(cell);
 			}
 		}
 
-		void line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const CellAttributes &attrs) const {
+		void line(int x0, int y0, int x1, int y1, const CellAttributes &attrs) const {
 			Cell cell(attrs.buildCell());
 
-			Graphics::bresenham(x0, y0, x1, y1, [&](uint16_t x, uint16_t y) {
+			Graphics::bresenham(x0, y0, x1, y1, _display.width(), _display.height(), [&](int x, int y) {
 				set(x, y, cell);
 			});
 		}
 
+		TextCache& textCache() const {
+			return _text_cache;
+		}
+
 	private:
 		Display& _display;
+		mutable TextCache _text_cache;
+
+		void cachedText(int x, int y, const TextCache::Entry &entry) const {
+			const bool complete = entry.attrs.isComplete();
+			Buffer::Span span = _display.span(y, x, _display.width() - 1);
+			int i = 0;
+
+			for (const Cell &glyph : entry.cells) {
+				if (x + i + glyph.width > _display.width()) {
+					return;
+				}
+
+				if (x + i < 0) {
+					i += glyph.width;
+					continue;
+				}
+
+				const uint16_t index = x + i - span.x();
+
+				if (complete) {
+					span.set(index, glyph);
+				} else {
+					Cell cell = span[index];
+					entry.attrs.applyFrom(glyph, cell);
+					cell.data = glyph.data;
+					cell.width = glyph.width;
+					span.set(index, cell);
+				}
+
+				i += glyph.width;
+			}
+		}
 
-		void set(uint16_t x, uint16_t y, const Cell& cell) const {
+		void set(int x, int y, const Cell& cell) const {
+			if (x < 0 || y < 0) { return; }
 			_display.set(x, y, cell);
 		}
 };
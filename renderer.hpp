@@ -0,0 +1,217 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include "display.hpp"
+#include "mesh.hpp"
+
+namespace Blurses {
+struct Light {
+	glm::vec3 ambient;
+	float ambientIntensity;
+	glm::vec3 diffuse;
+	float diffuseIntensity;
+	glm::vec3 direction;
+};
+
+// Draws meshes to the display as background colored cells, with a depth
+// buffer and per cell lighting. Transformed positions land directly on
+// cells, with the origin in the middle of the display; there is no
+// perspective divide. Normals are not transformed, so the light direction
+// is in model space.
+//
+// Scratch memory is kept between frames, drawing doesn't allocate once the
+// buffers have grown to the display and the largest mesh.
+class Renderer {
+	public:
+		Renderer()
+			: _width(0)
+			, _height(0) { }
+
+		// Starts a new frame.
+		void clear(const Display &display) {
+			_width = display.width();
+			_height = display.height();
+			_depth.assign(_width * _height, std::numeric_limits<float>::infinity());
+		}
+
+		void draw(Display &display, const Mesh &mesh, const glm::mat4 &transform, const Light &light) {
+			if (display.width() != _width || display.height() != _height) {
+				clear(display);
+			}
+
+			this->transform(mesh, transform);
+
+			_ambient = light.ambient * light.ambientIntensity;
+			_diffuse = light.diffuse * light.diffuseIntensity;
+			_direction = light.direction;
+			_cell = display.attr().fg(0xffffff).buildCell();
+
+			const std::vector<uint32_t> &indices = mesh._indices;
+
+			for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+				triangle(display, mesh, indices[i], indices[i + 1], indices[i + 2]);
+			}
+		}
+
+	private:
+		struct Vertex {
+			float x, y, z;
+			float r, g, b;
+			float nx, ny, nz;
+		};
+
+		uint16_t _width;
+		uint16_t _height;
+		std::vector<float> _depth;
+		// Transformed positions, one entry per mesh vertex.
+		std::vector<float> _x, _y, _z;
+		glm::vec3 _ambient;
+		glm::vec3 _diffuse;
+		glm::vec3 _direction;
+		Cell _cell;
+
+		// All positions in one pass, with the matrix unpacked to scalars so
+		// the loop is just multiplies and adds over the component arrays.
+		void transform(const Mesh &mesh, const glm::mat4 &m) {
+			const size_t count = mesh.vertexCount();
+			_x.resize(count);
+			_y.resize(count);
+			_z.resize(count);
+
+			const float m00 = m[0][0], m10 = m[1][0], m20 = m[2][0], m30 = m[3][0] + _width / 2.0f;
+			const float m01 = m[0][1], m11 = m[1][1], m21 = m[2][1], m31 = m[3][1] + _height / 2.0f;
+			const float m02 = m[0][2], m12 = m[1][2], m22 = m[2][2], m32 = m[3][2];
+			const float* x = mesh._x.data();
+			const float* y = mesh._y.data();
+			const float* z = mesh._z.data();
+
+			for (size_t i = 0; i < count; i++) {
+				_x[i] = m00 * x[i] + m10 * y[i] + m20 * z[i] + m30;
+				_y[i] = m01 * x[i] + m11 * y[i] + m21 * z[i] + m31;
+				_z[i] = m02 * x[i] + m12 * y[i] + m22 * z[i] + m32;
+			}
+		}
+
+		Vertex vertex(const Mesh &mesh, uint32_t i) const {
+			return {
+				_x[i], _y[i], _z[i],
+				mesh._r[i], mesh._g[i], mesh._b[i],
+				mesh._nx[i], mesh._ny[i], mesh._nz[i]
+			};
+		}
+
+		// (b - a) * scale, for every attribute.
+		static Vertex difference(const Vertex &a, const Vertex &b, float scale) {
+			return {
+				(b.x - a.x) * scale, (b.y - a.y) * scale, (b.z - a.z) * scale,
+				(b.r - a.r) * scale, (b.g - a.g) * scale, (b.b - a.b) * scale,
+				(b.nx - a.nx) * scale, (b.ny - a.ny) * scale, (b.nz - a.nz) * scale
+			};
+		}
+
+		static void advance(Vertex &v, const Vertex &step) {
+			v.x += step.x;
+			v.y += step.y;
+			v.z += step.z;
+			v.r += step.r;
+			v.g += step.g;
+			v.b += step.b;
+			v.nx += step.nx;
+			v.ny += step.ny;
+			v.nz += step.nz;
+		}
+
+		static Vertex lerp(const Vertex &a, const Vertex &b, float t) {
+			Vertex v = a;
+			advance(v, difference(a, b, t));
+			return v;
+		}
+
+		// Scanline fill, sampling each cell at its center. The rows are
+		// walked between the long edge and whichever of the two short
+		// edges spans the row, so no per-row edge lists are needed.
+		void triangle(Display &display, const Mesh &mesh, uint32_t i0, uint32_t i1, uint32_t i2) {
+			Vertex v0 = vertex(mesh, i0);
+			Vertex v1 = vertex(mesh, i1);
+			Vertex v2 = vertex(mesh, i2);
+
+			if (v1.y < v0.y) { std::swap(v0, v1); }
+			if (v2.y < v1.y) { std::swap(v1, v2); }
+			if (v1.y < v0.y) { std::swap(v0, v1); }
+
+			if (std::max({v0.x, v1.x, v2.x}) < 0 || std::min({v0.x, v1.x, v2.x}) >= _width) {
+				return;
+			}
+
+			const int first = std::max(0, static_cast<int>(std::ceil(v0.y - 0.5f)));
+			const int last = std::min<int>(_height, std::ceil(v2.y - 0.5f));
+
+			for (int y = first; y < last; y++) {
+				const float center = y + 0.5f;
+				Vertex left = lerp(v0, v2, (center - v0.y) / (v2.y - v0.y));
+				Vertex right = center < v1.y
+					? lerp(v0, v1, (center - v0.y) / (v1.y - v0.y))
+					: lerp(v1, v2, (center - v1.y) / (v2.y - v1.y));
+
+				if (right.x < left.x) {
+					std::swap(left, right);
+				}
+
+				row(display, y, left, right);
+			}
+		}
+
+		void row(Display &display, int y, const Vertex &left, const Vertex &right) {
+			const int x0 = std::ceil(left.x - 0.5f);
+			const int x1 = std::ceil(right.x - 0.5f) - 1;
+
+			if (x1 < x0) {
+				return;
+			}
+
+			Buffer::Span span = display.span(y, x0, x1);
+
+			if (span.empty()) {
+				return;
+			}
+
+			const float length = right.x - left.x;
+			const Vertex step = difference(left, right, 1.0f / length);
+			Vertex value = lerp(left, right, (span.x() + 0.5f - left.x) / length);
+
+			float* depth = &_depth[y * _width + span.x()];
+
+			for (uint16_t i = 0; i < span.size(); i++) {
+				if (value.z < depth[i]) {
+					depth[i] = value.z;
+					_cell.bg = display.color(shade(value));
+					span.set(i, _cell);
+				}
+
+				advance(value, step);
+			}
+		}
+
+		Color shade(const Vertex &v) const {
+			const float facing = -(v.nx * _direction.x + v.ny * _direction.y + v.nz * _direction.z);
+			const float factor = std::min(std::max(facing, 0.0f), 1.0f);
+
+			return Color(
+				channel(v.r * (_ambient.r + factor * _diffuse.r)),
+				channel(v.g * (_ambient.g + factor * _diffuse.g)),
+				channel(v.b * (_ambient.b + factor * _diffuse.b))
+			);
+		}
+
+		static uint8_t channel(float value) {
+			return std::min(std::max(value, 0.0f), 1.0f) * 255;
+		}
+};
+};
+
+#endif
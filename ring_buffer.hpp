@@ -0,0 +1,112 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+namespace Blurses {
+// Bounded single-producer/single-consumer queue. push() may only be called
+// from one thread and drain() from one other thread. A consumer that stops
+// draining should close() the queue, so a blocked producer gives up.
+template <typename T, size_t N>
+class RingBuffer {
+	static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer size must be a power of two");
+
+	public:
+		enum OverflowPolicy {
+			DROP_NEWEST,
+			BLOCK,
+		};
+
+		RingBuffer(OverflowPolicy policy = DROP_NEWEST)
+			: _policy(policy)
+			, _head(0)
+			, _tail(0)
+			, _dropped(0)
+			, _closed(false) { }
+
+		bool push(const T& value) {
+			const size_t head = _head.load(std::memory_order_relaxed);
+
+			while (head - _tail.load(std::memory_order_acquire) == N) {
+				if (_policy == DROP_NEWEST) {
+					_dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				if (_closed.load(std::memory_order_acquire)) {
+					_dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				std::this_thread::yield();
+			}
+
+			_items[head & (N - 1)] = value;
+			_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Calls fn for every queued item in place, then releases them all at once.
+		template <typename F>
+		size_t drain(F fn) {
+			const size_t tail = _tail.load(std::memory_order_relaxed);
+			const size_t head = _head.load(std::memory_order_acquire);
+
+			for (size_t i = tail; i != head; i++) {
+				fn(_items[i & (N - 1)]);
+			}
+
+			_tail.store(head, std::memory_order_release);
+			return head - tail;
+		}
+
+		// Makes push() return false instead of waiting for room.
+		void close() {
+			_closed.store(true, std::memory_order_release);
+		}
+
+		bool closed() const {
+			return _closed.load(std::memory_order_acquire);
+		}
+
+		// Position the next pushed item will get, only valid on the producer.
+		size_t position() const {
+			return _head.load(std::memory_order_relaxed);
+		}
+
+		// Whether the consumer is done with the item pushed at position.
+		bool consumed(size_t position) const {
+			return _tail.load(std::memory_order_acquire) > position;
+		}
+
+		bool empty() const {
+			return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+		}
+
+		size_t dropped() const {
+			return _dropped.load(std::memory_order_relaxed);
+		}
+
+		static constexpr size_t capacity() {
+			return N;
+		}
+
+	private:
+		const OverflowPolicy _policy;
+		std::array<T, N> _items;
+		// Padded to keep the producer's and the consumer's counters on
+		// separate cache lines. Padding rather than alignas(64), which would
+		// need C++17 aligned new for heap allocated owners.
+		char _items_padding[64];
+		std::atomic<size_t> _head;
+		char _head_padding[64 - sizeof(std::atomic<size_t>)];
+		std::atomic<size_t> _tail;
+		char _tail_padding[64 - sizeof(std::atomic<size_t>)];
+		std::atomic<size_t> _dropped;
+		std::atomic<bool> _closed;
+};
+};
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef SIMD_UTF8_HPP
+#define SIMD_UTF8_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BLURSES_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define BLURSES_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Vectorized UTF-8 validation and ASCII scanning. On x86 the widest
+// implementation supported by the CPU is picked at runtime, every function
+// has a scalar fallback.
+namespace Blurses {
+namespace SimdUtf8 {
+	typedef size_t (*prefix_func)(const char*, const char*);
+	typedef bool (*validate_func)(const char*, const char*);
+
+	// Bytes 0x20-0x7e, a run of them is a run of one column graphemes.
+	inline bool isPrintableAscii(uint8_t c) {
+		return c >= 0x20 && c < 0x7f;
+	}
+
+	inline size_t printablePrefixScalar(const char *start, const char *end) {
+		const char *curr = start;
+
+		while (curr + 8 <= end) {
+			uint64_t word;
+			std::memcpy(&word, curr, sizeof word);
+
+			// High bit set in a byte of low or high if it is < 0x20 or >= 0x7f.
+			const uint64_t low = word - 0x2020202020202020ULL;
+			const uint64_t high = word + 0x0101010101010101ULL;
+
+			if (((low | high | word) & 0x8080808080808080ULL) != 0) {
+				break;
+			}
+
+			curr += 8;
+		}
+
+		while (curr != end && isPrintableAscii(*curr)) {
+			curr++;
+		}
+
+		return curr - start;
+	}
+
+	// Scalar validation of one sequence, returns the byte after it or nullptr.
+	inline const uint8_t* validateSequence(const uint8_t *curr, const uint8_t *end) {
+		const uint8_t c = *curr;
+		size_t len;
+		uint8_t min = 0x80;
+		uint8_t max = 0xbf;
+
+		if (c < 0x80) { return curr + 1; }
+		else if (c >= 0xc2 && c <= 0xdf) { len = 2; }
+		else if (c >= 0xe0 && c <= 0xef) { len = 3; if (c == 0xe0) { min = 0xa0; } if (c == 0xed) { max = 0x9f; } }
+		else if (c >= 0xf0 && c <= 0xf4) { len = 4; if (c == 0xf0) { min = 0x90; } if (c == 0xf4) { max = 0x8f; } }
+		else { return nullptr; }
+
+		if (static_cast<size_t>(end - curr) < len) { return nullptr; }
+		if (curr[1] < min || curr[1] > max) { return nullptr; }
+
+		for (size_t i = 2; i < len; i++) {
+			if ((curr[i] & 0xc0) != 0x80) {
+				return nullptr;
+			}
+		}
+
+		return curr + len;
+	}
+
+	inline bool validateScalar(const char *start, const char *end) {
+		const uint8_t *curr = reinterpret_cast<const uint8_t*>(start);
+		const uint8_t *last = reinterpret_cast<const uint8_t*>(end);
+
+		while (curr != last) {
+			curr += printablePrefixScalar(reinterpret_cast<const char*>(curr), end);
+
+			if (curr == last) {
+				break;
+			}
+
+			curr = validateSequence(curr, last);
+
+			if (!curr) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+#if BLURSES_SIMD_X86
+	inline size_t printablePrefixSse2(const char *start, const char *end) {
+		const char *curr = start;
+		const __m128i below = _mm_set1_epi8(0x20);
+		const __m128i above = _mm_set1_epi8(0x7e);
+
+		while (curr + 16 <= end) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(curr));
+			// Signed compares, so bytes >= 0x80 are negative and fail the first.
+			const __m128i bad = _mm_or_si128(_mm_cmplt_epi8(v, below), _mm_cmpgt_epi8(v, above));
+			const int mask = _mm_movemask_epi8(bad);
+
+			if (mask != 0) {
+				return curr - start + __builtin_ctz(mask);
+			}
+
+			curr += 16;
+		}
+
+		return curr - start + printablePrefixScalar(curr, end);
+	}
+
+	__attribute__((target("avx2")))
+	inline size_t printablePrefixAvx2(const char *start, const char *end) {
+		const char *curr = start;
+		const __m256i below = _mm256_set1_epi8(0x1f);
+		const __m256i above = _mm256_set1_epi8(0x7f);
+
+		while (curr + 32 <= end) {
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(curr));
+			const __m256i good = _mm256_and_si256(_mm256_cmpgt_epi8(v, below), _mm256_cmpgt_epi8(above, v));
+			const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(good));
+
+			if (mask != 0) {
+				return curr - start + __builtin_ctz(mask);
+			}
+
+			curr += 32;
+		}
+
+		return curr - start + printablePrefixSse2(curr, end);
+	}
+
+	// Lookup table validation by Keiser and Lemire, "Validating UTF-8 in less
+	// than one instruction per byte". Each block is checked against the last
+	// three bytes of the previous one.
+	struct Ssse3Validator {
+		__m128i error;
+		__m128i prev_input;
+		__m128i prev_incomplete;
+
+		__attribute__((target("ssse3")))
+		void check(__m128i input) {
+			if (_mm_movemask_epi8(input) == 0) {
+				error = _mm_or_si128(error, prev_incomplete);
+				prev_input = input;
+				prev_incomplete = _mm_setzero_si128();
+				return;
+			}
+
+			const uint8_t TOO_SHORT = 1 << 0;
+			const uint8_t TOO_LONG = 1 << 1;
+			const uint8_t OVERLONG_3 = 1 << 2;
+			const uint8_t TOO_LARGE = 1 << 3;
+			const uint8_t SURROGATE = 1 << 4;
+			const uint8_t OVERLONG_2 = 1 << 5;
+			const uint8_t TOO_LARGE_1000 = 1 << 6;
+			const uint8_t OVERLONG_4 = 1 << 6;
+			const uint8_t TWO_CONTS = 1 << 7;
+			const uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+			const __m128i low_nibble = _mm_set1_epi8(0x0f);
+			const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+
+			const __m128i byte_1_high = _mm_shuffle_epi8(_mm_setr_epi8(
+				TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+				TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+				TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+				TOO_SHORT | OVERLONG_2,
+				TOO_SHORT,
+				TOO_SHORT | OVERLONG_3 | SURROGATE,
+				TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+			), _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+
+			const __m128i byte_1_low = _mm_shuffle_epi8(_mm_setr_epi8(
+				CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+				CARRY | OVERLONG_2,
+				CARRY,
+				CARRY,
+				CARRY | TOO_LARGE,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+				CARRY | TOO_LARGE | TOO_LARGE_1000,
+				CARRY | TOO_LARGE | TOO_LARGE_1000
+			), _mm_and_si128(prev1, low_nibble));
+
+			const __m128i byte_2_high = _mm_shuffle_epi8(_mm_setr_epi8(
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+				TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+				TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+			), _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+
+			const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+			// Third and fourth bytes of a sequence must be continuations.
+			const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+			const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+			const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+			const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+			const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+
+			error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+
+			// A lead byte in the last three positions needs the next block.
+			const __m128i max = _mm_setr_epi8(
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1)
+			);
+			prev_incomplete = _mm_subs_epu8(input, max);
+			prev_input = input;
+		}
+	};
+
+	__attribute__((target("ssse3")))
+	inline bool validateSsse3(const char *start, const char *end) {
+		Ssse3Validator validator;
+		validator.error = _mm_setzero_si128();
+		validator.prev_input = _mm_setzero_si128();
+		validator.prev_incomplete = _mm_setzero_si128();
+
+		const char *curr = start;
+
+		while (curr + 16 <= end) {
+			validator.check(_mm_loadu_si128(reinterpret_cast<const __m128i*>(curr)));
+			curr += 16;
+		}
+
+		if (curr != end) {
+			char tail[16] = {0};
+			std::memcpy(tail, curr, end - curr);
+			validator.check(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)));
+		}
+
+		const __m128i error = _mm_or_si128(validator.error, validator.prev_incomplete);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xffff;
+	}
+#elif BLURSES_SIMD_NEON
+	inline size_t printablePrefixNeon(const char *start, const char *end) {
+		const char *curr = start;
+		const uint8x16_t below = vdupq_n_u8(0x20);
+		const uint8x16_t above = vdupq_n_u8(0x7e);
+
+		while (curr + 16 <= end) {
+			const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(curr));
+			const uint8x16_t bad = vorrq_u8(vcltq_u8(v, below), vcgtq_u8(v, above));
+
+			if (vmaxvq_u8(bad) != 0) {
+				break;
+			}
+
+			curr += 16;
+		}
+
+		return curr - start + printablePrefixScalar(curr, end);
+	}
+#endif
+
+	inline prefix_func selectPrintablePrefix() {
+#if BLURSES_SIMD_X86
+		if (__builtin_cpu_supports("avx2")) {
+			return printablePrefixAvx2;
+		}
+
+		return printablePrefixSse2;
+#elif BLURSES_SIMD_NEON
+		return printablePrefixNeon;
+#else
+		return printablePrefixScalar;
+#endif
+	}
+
+	inline validate_func selectValidate() {
+#if BLURSES_SIMD_X86
+		if (__builtin_cpu_supports("ssse3")) {
+			return validateSsse3;
+		}
+#endif
+		return validateScalar;
+	}
+
+	// Number of leading bytes in 0x20-0x7e.
+	inline size_t printablePrefix(const char *start, const char *end) {
+		static const prefix_func fn = selectPrintablePrefix();
+		return fn(start, end);
+	}
+
+	inline bool validate(const char *start, const char *end) {
+		static const validate_func fn = selectValidate();
+		return fn(start, end);
+	}
+};
+};
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef SPRITE_HPP
+#define SPRITE_HPP
+
+#include <vector>
+#include <algorithm>
+#include "display.hpp"
+#include "braille_buffer.hpp"
+#include "utfstring.hpp"
+
+namespace Blurses {
+// A prebuilt block of cells, blitted as a whole. Cells can be transparent,
+// leaving what's under them. Rows without transparent cells are copied in
+// one go, the others cell by cell.
+class Sprite {
+	public:
+		Sprite(uint16_t width, uint16_t height)
+			: _width(width)
+			, _height(height)
+			, _words((width + 63) / 64) {
+			_cells.resize(_width * _height, Cell());
+			_mask.resize(_words * _height, 0);
+			_opaque.resize(_height, 0);
+		}
+
+		// One row per line of text. Cells past the end of a line are
+		// transparent, and so are spaces if spacesAreTransparent is set.
+		static Sprite text(const utfstring &text, const CellAttributes &attrs, bool spacesAreTransparent = false) {
+			std::vector<utfstring::grapheme_range> lines;
+			const char* start = text.data();
+			const char* end = start + text.size();
+			uint16_t width = 0;
+
+			while (true) {
+				const char* newline = std::find(start, end, '\n');
+				lines.push_back(utfstring::grapheme_range(start, newline));
+				width = std::max<uint16_t>(width, utfstring(std::string(start, newline)).width());
+
+				if (newline == end) {
+					break;
+				}
+
+				start = newline + 1;
+			}
+
+			Sprite sprite(width, lines.size());
+			Cell cell(attrs.buildCell());
+
+			for (uint16_t y = 0; y < lines.size(); y++) {
+				uint16_t x = 0;
+
+				for (const utfstring::grapheme &ch : lines[y]) {
+					if (!(spacesAreTransparent && ch.size == 1 && *ch.data == ' ')) {
+						cell.data.assign(ch.data, ch.size);
+						cell.width = ch.width;
+						sprite.set(x, y, cell);
+					}
+
+					x += ch.width;
+				}
+			}
+
+			return sprite;
+		}
+
+		// One cell per braille cell, with empty ones transparent if
+		// emptyIsTransparent is set.
+		static Sprite braille(const BrailleBuffer &buffer, const CellAttributes &attrs, bool emptyIsTransparent = true) {
+			Sprite sprite(buffer.columns(), buffer.rows());
+			Cell cell(attrs.buildCell());
+
+			for (uint16_t y = 0; y < buffer.rows(); y++) {
+				for (uint16_t x = 0; x < buffer.columns(); x++) {
+					const uint8_t dots = buffer.cell(x, y);
+
+					if (dots || !emptyIsTransparent) {
+						cell.data.assign(BrailleBuffer::glyph(dots), 3);
+						sprite.set(x, y, cell);
+					}
+				}
+			}
+
+			return sprite;
+		}
+
+		uint16_t width() const {
+			return _width;
+		}
+
+		uint16_t height() const {
+			return _height;
+		}
+
+		// Makes the cell opaque. A wide cell takes the next cell too.
+		// Overwriting one half of a wide cell blanks the other half.
+		void set(uint16_t x, uint16_t y, const Cell &cell) {
+			if (x >= _width || y >= _height) {
+				return;
+			}
+
+			split(x, y);
+			Cell &target = _cells[y * _width + x];
+			target = cell;
+			show(x, y);
+
+			if (cell.isWide()) {
+				if (x + 1 >= _width) {
+					blank(target);
+					return;
+				}
+
+				split(x + 1, y);
+				Cell &continuation = _cells[y * _width + x + 1];
+				continuation = cell;
+				continuation.data.clear();
+				continuation.width = 0;
+				show(x + 1, y);
+			}
+		}
+
+		// Hiding one half of a wide cell blanks the other half.
+		void hide(uint16_t x, uint16_t y) {
+			if (x >= _width || y >= _height) {
+				return;
+			}
+
+			if (isOpaque(x, y)) {
+				split(x, y);
+				blank(_cells[y * _width + x]);
+				_mask[y * _words + x / 64] &= ~(uint64_t(1) << (x % 64));
+				_opaque[y]--;
+			}
+		}
+
+		bool isOpaque(uint16_t x, uint16_t y) const {
+			return (_mask[y * _words + x / 64] >> (x % 64)) & 1;
+		}
+
+		const Cell& get(uint16_t x, uint16_t y) const {
+			return _cells[y * _width + x];
+		}
+
+		// Draws the sprite with its top left cell at x, y, clipped to the
+		// display.
+		void blit(Display &display, int x, int y) const {
+			const int top = std::max(y, 0);
+			const int bottom = std::min(y + _height, int(display.height()));
+
+			for (int row = top; row < bottom; row++) {
+				Buffer::Span span = display.span(row, x, x + _width - 1);
+
+				if (span.empty()) {
+					return;
+				}
+
+				const uint16_t sy = row - y;
+				const uint16_t sx = span.x() - x;
+				const Cell* cells = &_cells[sy * _width + sx];
+
+				if (_opaque[sy] == _width) {
+					span.assign(cells);
+					continue;
+				}
+
+				for (uint16_t i = 0; i < span.size(); i++) {
+					if (!isOpaque(sx + i, sy)) {
+						continue;
+					}
+
+					if (cells[i].isContinuation()) {
+						if (i == 0) {
+							Cell cell = cells[i];
+							cell.data = " ";
+							cell.width = 1;
+							span.set(i, cell);
+						}
+
+						continue;
+					}
+
+					span.set(i, cells[i]);
+				}
+			}
+		}
+
+	private:
+		uint16_t _width;
+		uint16_t _height;
+		uint16_t _words;
+		std::vector<Cell> _cells;
+		// One bit per cell, set for opaque ones, in 64 bit words per row.
+		std::vector<uint64_t> _mask;
+		// Number of opaque cells in each row.
+		std::vector<uint16_t> _opaque;
+
+		// Same as Buffer::splitWide, for the cell about to change at x, y.
+		void split(uint16_t x, uint16_t y) {
+			const Cell &cell = _cells[y * _width + x];
+
+			if (cell.isContinuation() && x > 0) {
+				blank(_cells[y * _width + x - 1]);
+			} else if (cell.isWide() && x + 1 < _width) {
+				blank(_cells[y * _width + x + 1]);
+			}
+		}
+
+		static void blank(Cell &cell) {
+			cell.data = " ";
+			cell.width = 1;
+		}
+
+		void show(uint16_t x, uint16_t y) {
+			if (!isOpaque(x, y)) {
+				_mask[y * _words + x / 64] |= uint64_t(1) << (x % 64);
+				_opaque[y]++;
+			}
+		}
+};
+};
+
+#endif
@@ -1,5 +1,1050 @@
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include "test.hpp"
 #include "input.hpp"
+#include "input_parser.hpp"
 #include "utfstring.hpp"
+#include "graphics.hpp"
+#include "video.hpp"
+#include "renderer.hpp"
+#include "braille_chart.hpp"
+#include "display_list.hpp"
+#include "text_layout.hpp"
+
+namespace {
+int failures = 0;
+
+void check(bool ok, const std::string &what) {
+	if (!ok) {
+		std::cerr << "FAIL " << what << std::endl;
+		failures++;
+	}
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Display writes terminal setup sequences to stdout, which would clear the
+// test output. Failures go to stderr, so they show through this.
+class QuietStdout {
+	public:
+		QuietStdout() : _saved(std::cout.rdbuf(_sink.rdbuf())) { }
+		~QuietStdout() { std::cout.rdbuf(_saved); }
+
+	private:
+		std::ostringstream _sink;
+		std::streambuf* _saved;
+};
+
+// Writes everything the parser reports as one string per event. Text and
+// paste data are joined with what came right before them, since how they
+// are split depends on the reads.
+struct RecordingSink {
+	std::vector<std::string> events;
+
+	void pushBuffer(const Blurses::Key& key) {
+		events.push_back(describe(key));
+	}
+
+	void pushText(const char *data, size_t len) {
+		append("text ", data, len);
+	}
+
+	void pushPaste(const char *data, size_t len) {
+		append("paste ", data, len);
+	}
+
+	void endPaste() {
+		events.push_back("end paste");
+	}
+
+	void pushMouse(const Blurses::Key& key) {
+		events.push_back(describe(key));
+	}
+
+	void append(const std::string &prefix, const char *data, size_t len) {
+		if (events.empty() || events.back().compare(0, prefix.size(), prefix) != 0) {
+			events.push_back(prefix);
+		}
+
+		events.back().append(data, len);
+	}
+
+	static std::string describe(const Blurses::Key& key) {
+		return
+			"key " + std::to_string(key.type) +
+			" mod " + std::to_string(key.modifiers) +
+			" button " + std::to_string(key.button) +
+			" at " + std::to_string(key.x) + "," + std::to_string(key.y) +
+			" " + key.str();
+	}
+};
+
+struct CountingSink {
+	size_t count = 0;
+
+	void pushBuffer(const Blurses::Key&) { count++; }
+	void pushText(const char*, size_t len) { count += len; }
+	void pushPaste(const char*, size_t len) { count += len; }
+	void endPaste() { count++; }
+	void pushMouse(const Blurses::Key&) { count++; }
+};
+
+const char* const INPUT_SAMPLES[] = {
+	"hello", "åäö", "👨‍👩‍👧‍👦", "\r", "\t", "\x7f",
+	"\033[A", "\033[1;5C", "\033OP", "\033O2Q", "\033[15;2~", "\033[3~", "\033[Z",
+	"\033x", "\033\033[B", "\033\x01",
+	"\033[200~pasted \033[20 text åäö\033[201~",
+	"\033[200~\033[201~",
+	"\033[<0;10;5M", "\033[<0;10;5m", "\033[<32;11;6M", "\033[<35;3;4M",
+	"\033[<64;1;1M", "\033[<65;2;2M", "\033[<66;3;3M", "\033[<67;4;4M", "\033[<20;300;200M",
+};
+
+std::string randomInput(std::mt19937 &rng, size_t samples) {
+	const size_t count = sizeof INPUT_SAMPLES / sizeof INPUT_SAMPLES[0];
+	std::string input;
+
+	for (size_t i = 0; i < samples; i++) {
+		input += INPUT_SAMPLES[rng() % count];
+	}
+
+	return input;
+}
+
+// Feeding the same bytes in random pieces must give the same events as
+// feeding them all at once.
+void testInputParserSplits() {
+	std::mt19937 rng(28);
+
+	for (int round = 0; round < 2000; round++) {
+		const std::string input = randomInput(rng, 1 + rng() % 12);
+
+		RecordingSink whole;
+		Blurses::InputParser<RecordingSink>(whole).feed(input.data(), input.size());
+
+		RecordingSink split;
+		Blurses::InputParser<RecordingSink> parser(split);
+
+		for (size_t i = 0; i < input.size();) {
+			const size_t len = std::min<size_t>(1 + rng() % 8, input.size() - i);
+			parser.feed(input.data() + i, len);
+			i += len;
+		}
+
+		if (whole.events != split.events) {
+			check(false, "input parser split, round " + std::to_string(round));
+			return;
+		}
+	}
+}
+
+void testMouseWheel() {
+	const char input[] = "\033[<64;1;1M\033[<65;1;1M\033[<66;1;1M\033[<67;1;1M";
+	RecordingSink sink;
+	Blurses::InputParser<RecordingSink>(sink).feed(input, sizeof input - 1);
+
+	const Blurses::Key::TYPE expected[] = {
+		Blurses::Key::MOUSE_SCROLL_UP,
+		Blurses::Key::MOUSE_SCROLL_DOWN,
+		Blurses::Key::MOUSE_SCROLL_LEFT,
+		Blurses::Key::MOUSE_SCROLL_RIGHT
+	};
+
+	check(sink.events.size() == 4, "mouse wheel event count");
+
+	for (size_t i = 0; i < 4 && i < sink.events.size(); i++) {
+		const std::string prefix = "key " + std::to_string(expected[i]) + " ";
+		check(sink.events[i].compare(0, prefix.size(), prefix) == 0, "mouse wheel " + std::to_string(i));
+	}
+}
+
+// A grapheme longer than Key::TEXT_SIZE still arrives as one key.
+void testLongGrapheme() {
+	const std::string family = "👨‍👩‍👧‍👦";
+	const std::string input = "a" + family + "b\033[A";
+
+	Blurses::KeyBuilder keys;
+	Blurses::InputParser<Blurses::KeyBuilder> parser(keys);
+	parser.feed(input.data(), input.size());
+	keys.flush();
+
+	std::vector<std::string> texts;
+	bool up = false;
+
+	keys.getBuffer().drain([&](const Blurses::Key &key) {
+		if (key.type == Blurses::Key::DATA) {
+			texts.push_back(key.str());
+		}
+
+		up = key.type == Blurses::Key::KEY_UP;
+	});
+
+	check(texts == std::vector<std::string>({"a", family, "b"}) && up, "long grapheme in one key");
+}
+
+// A producer blocked on a full BLOCK queue gives up once it is closed.
+void testRingBufferClose() {
+	Blurses::RingBuffer<int, 2> ring(Blurses::RingBuffer<int, 2>::BLOCK);
+	ring.push(1);
+	ring.push(2);
+
+	bool pushed = true;
+	std::thread producer([&]() { pushed = ring.push(3); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	ring.close();
+	producer.join();
+
+	check(!pushed && ring.dropped() == 1, "closed ring releases a blocked push");
+}
+
+void testUnicodeWidth() {
+	using Blurses::Unicode::width;
+
+	check(width('a') == 1 && width(0x4e00) == 2 && width(0x0301) == 0, "assigned widths");
+	check(width(0x0378) == 1 && width(0xe01f0) == 1, "unassigned codepoints are one column");
+	check(width(0xfffe) == 1 && width(0x10ffff) == 1, "noncharacters are one column");
+	check(width(0x2a6e0) == 2, "unassigned ideographic plane codepoints are wide");
+}
+
+// Draws the chart's dots for every series, which the chart ORs together.
+std::vector<uint8_t> chartDots(const Blurses::BrailleChart &chart) {
+	std::vector<uint8_t> dots;
+	QuietStdout quiet;
+	Blurses::Display display;
+	display.resize(chart.columns(), chart.rows());
+	chart.draw(display, 0, 0, display.attr());
+
+	for (uint16_t y = 0; y < chart.rows(); y++) {
+		for (uint16_t x = 0; x < chart.columns(); x++) {
+			const std::string data = display.get(x, y).data;
+			// U+2800 + dots, encoded as E2 A0-A3 80-BF.
+			dots.push_back((uint8_t(data[1]) & 0x03) << 6 | (uint8_t(data[2]) & 0x3f));
+		}
+	}
+
+	return dots;
+}
+
+// The chart scrolls its pixel ring and only rasterizes new columns. It
+// must show the same dots as drawing every kept column again from the
+// full history, with random samples, NaN gaps and bucket sizes.
+void testBrailleChart() {
+	struct Bucket {
+		float min, max, last;
+	};
+
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<float> sample(-1.3f, 1.3f);
+	const uint16_t columns = 7;
+	const uint16_t rows = 3;
+	const int width = columns * 2;
+	const int height = rows * 4;
+	bool same = true;
+
+	auto toY = [&](float value, float min, float max) {
+		const float t = std::min(std::max((value - min) / (max - min), 0.0f), 1.0f);
+		return static_cast<int>(std::lround((1.0f - t) * (height - 1)));
+	};
+
+	// windowed: whether the oldest kept column connects to the one before
+	// it, which is only redrawn by setRange().
+	auto reference = [&](const std::vector<std::vector<Bucket> > &history, float min, float max, bool windowed) {
+		std::vector<uint8_t> dots(columns * rows, 0);
+
+		for (const std::vector<Bucket> &buckets : history) {
+			Blurses::BrailleBuffer pixels(width, height);
+			const size_t first = buckets.size() > size_t(width) ? buckets.size() - width : 0;
+
+			for (size_t i = first; i < buckets.size(); i++) {
+				if (std::isnan(buckets[i].last)) {
+					continue;
+				}
+
+				int top = toY(buckets[i].max, min, max);
+				int bottom = toY(buckets[i].min, min, max);
+
+				if (i > (windowed ? first : 0) && !std::isnan(buckets[i - 1].last)) {
+					top = std::min(top, toY(buckets[i - 1].last, min, max));
+					bottom = std::max(bottom, toY(buckets[i - 1].last, min, max));
+				}
+
+				pixels.vline(i - first, top, bottom);
+			}
+
+			for (uint16_t y = 0; y < rows; y++) {
+				for (uint16_t x = 0; x < columns; x++) {
+					dots[y * columns + x] |= pixels.cell(x, y);
+				}
+			}
+		}
+
+		return dots;
+	};
+
+	for (uint16_t samples = 1; samples <= 3; samples++) {
+		Blurses::BrailleChart chart(columns, rows, -1.0f, 1.0f, samples);
+		chart.addSeries(Blurses::Color(255, 0, 0));
+		chart.addSeries(Blurses::Color(0, 255, 0));
+		std::vector<std::vector<Bucket> > history(2);
+		Bucket pending[2];
+
+		for (int i = 0; i < 200; i++) {
+			float values[2];
+
+			for (int series = 0; series < 2; series++) {
+				values[series] = rng() % 10 == 0 ? NAN : sample(rng);
+
+				if (i % samples == 0) {
+					pending[series] = {NAN, NAN, NAN};
+				}
+
+				if (!std::isnan(values[series])) {
+					Bucket &bucket = pending[series];
+					const bool empty = std::isnan(bucket.last);
+					bucket.min = empty ? values[series] : std::min(bucket.min, values[series]);
+					bucket.max = empty ? values[series] : std::max(bucket.max, values[series]);
+					bucket.last = values[series];
+				}
+			}
+
+			chart.push(values, 2);
+
+			if (i % samples == samples - 1) {
+				history[0].push_back(pending[0]);
+				history[1].push_back(pending[1]);
+				same = same && chartDots(chart) == reference(history, -1.0f, 1.0f, false);
+			}
+		}
+
+		chart.setRange(-0.5f, 2.0f);
+		same = same && chartDots(chart) == reference(history, -0.5f, 2.0f, true);
+	}
+
+	check(same, "braille chart matches redrawing the whole history");
+}
+
+// Every vectorized path the CPU supports, and the dispatched one, must
+// agree with the scalar functions. The inputs are valid UTF-8 with random
+// bytes mixed in, so they hit truncated, overlong and surrogate sequences,
+// at every alignment.
+void testClippedLines() {
+	const int width = 60;
+	const int height = 40;
+	std::mt19937 rng(5);
+	auto coordinate = [&](int size, int spread) { return int(rng() % (size + 2 * spread)) - spread; };
+	size_t differing = 0;
+
+	for (int round = 0; round < 200000; round++) {
+		const int spread = round % 2 ? 20 : 2000;
+		const int x0 = coordinate(width, spread);
+		const int y0 = coordinate(height, spread);
+		const int x1 = coordinate(width, spread);
+		const int y1 = coordinate(height, spread);
+		std::vector<std::pair<int, int> > whole;
+		std::vector<std::pair<int, int> > clipped;
+
+		Graphics::bresenham(x0, y0, x1, y1, [&](int x, int y) {
+			if (x < width && y < height) {
+				whole.push_back({x, y});
+			}
+		});
+		Graphics::bresenham(x0, y0, x1, y1, width, height, [&](int x, int y) {
+			clipped.push_back({x, y});
+		});
+
+		if (whole != clipped) {
+			differing++;
+		}
+	}
+
+	check(differing == 0, "clipped lines draw the visible pixels of the whole line, " + std::to_string(differing) + " differ");
+
+	size_t far = 0;
+	Graphics::bresenham(-1000000000, -999999990, 1000000000, 1000000010, width, height, [&](int, int) { far++; });
+	check(far == 30, "a clipped line far outside the bounds draws " + std::to_string(far) + " pixels");
+}
+
+void testTextLayoutWidths() {
+	const char* words[] = {"a", "word", "longerword", "日本語", "x", "  ", "wrapping"};
+	const uint16_t widths[] = {7, 20, 1, 33, 12};
+	std::mt19937 rng(3);
+	std::vector<std::string> paragraphs;
+	Blurses::TextLayout layout(20);
+	bool same = true;
+
+	auto text = [&]() {
+		std::string result;
+
+		for (int i = rng() % 12; i >= 0; i--) {
+			result += words[rng() % 7];
+			result += ' ';
+		}
+
+		return result;
+	};
+
+	auto lines = [](const Blurses::TextLayout &layout) {
+		std::vector<std::string> result;
+
+		for (size_t i = 0; i < layout.lineCount(); i++) {
+			std::string line;
+
+			for (const auto &g : layout.line(i)) {
+				line.append(g.data, g.size);
+			}
+
+			result.push_back(line);
+		}
+
+		return result;
+	};
+
+	for (int round = 0; round < 300; round++) {
+		const int action = rng() % 4;
+
+		if (action == 0) {
+			layout.setWidth(widths[rng() % 5]);
+		} else if (action == 1 && !paragraphs.empty()) {
+			const std::string more = text();
+			layout.extend(more);
+			paragraphs.back() += more;
+		} else {
+			const std::string more = text();
+			layout.append(more);
+			paragraphs.push_back(more);
+		}
+
+		Blurses::TextLayout fresh(layout.width());
+
+		for (const std::string &paragraph : paragraphs) {
+			fresh.append(paragraph);
+		}
+
+		same = same && layout.paragraphCount() == paragraphs.size() && lines(layout) == lines(fresh);
+	}
+
+	check(same, "text layout lines match a fresh layout after switching widths");
+}
+
+void testSimdUtf8() {
+	using namespace Blurses::SimdUtf8;
+
+	std::vector<std::pair<std::string, validate_func> > validators = {{"dispatched", validate}};
+	std::vector<std::pair<std::string, prefix_func> > prefixes = {{"dispatched", printablePrefix}};
+
+#if BLURSES_SIMD_X86
+	prefixes.push_back({"sse2", printablePrefixSse2});
+
+	if (__builtin_cpu_supports("avx2")) {
+		prefixes.push_back({"avx2", printablePrefixAvx2});
+	}
+
+	if (__builtin_cpu_supports("ssse3")) {
+		validators.push_back({"ssse3", validateSsse3});
+	}
+#elif BLURSES_SIMD_NEON
+	prefixes.push_back({"neon", printablePrefixNeon});
+#endif
+
+	std::mt19937 rng(3);
+	std::vector<size_t> validate_mismatches(validators.size());
+	std::vector<size_t> prefix_mismatches(prefixes.size());
+	size_t valid = 0;
+
+	for (int round = 0; round < 100000; round++) {
+		std::string input(rng() % 8, ' ');
+		const size_t offset = input.size();
+		const size_t length = rng() % 100;
+
+		while (input.size() < offset + length) {
+			const uint32_t kind = rng() % 8;
+
+			if (kind < 4) {
+				input.append(rng() % 40, static_cast<char>(0x20 + rng() % 0x5f));
+			} else if (kind < 7) {
+				// Any codepoint, surrogates included.
+				const uint32_t max[] = {0x7ff, 0xffff, 0x10ffff};
+				const uint32_t cp = 0x80 + rng() % max[kind - 4];
+				char bytes[4];
+				const size_t size = cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+				const uint8_t lead[] = {0, 0, 0xc0, 0xe0, 0xf0};
+				bytes[0] = static_cast<char>(lead[size] | cp >> (6 * (size - 1)));
+
+				for (size_t i = 1; i < size; i++) {
+					bytes[i] = static_cast<char>(0x80 | ((cp >> (6 * (size - 1 - i))) & 0x3f));
+				}
+
+				input.append(bytes, size);
+			} else {
+				input += static_cast<char>(rng() % 256);
+			}
+		}
+
+		input.resize(offset + length);
+
+		if (length > 0 && rng() % 4 == 0) {
+			input[offset + rng() % length] = static_cast<char>(rng() % 256);
+		}
+
+		const char* start = input.data() + offset;
+		const char* end = start + length;
+		const bool expected = validateScalar(start, end);
+		const size_t prefix = printablePrefixScalar(start, end);
+		valid += expected;
+
+		for (size_t i = 0; i < validators.size(); i++) {
+			validate_mismatches[i] += validators[i].second(start, end) != expected;
+		}
+
+		for (size_t i = 0; i < prefixes.size(); i++) {
+			prefix_mismatches[i] += prefixes[i].second(start, end) != prefix;
+		}
+	}
+
+	for (size_t i = 0; i < validators.size(); i++) {
+		check(validate_mismatches[i] == 0, validators[i].first + " validate agrees with validateScalar");
+	}
+
+	for (size_t i = 0; i < prefixes.size(); i++) {
+		check(prefix_mismatches[i] == 0, prefixes[i].first + " printablePrefix agrees with printablePrefixScalar");
+	}
+
+	check(valid > 10000 && valid < 90000, "simd utf-8 inputs mix valid and invalid text");
+}
+
+// A row of a buffer as text, with "~" for continuation cells. Widths that
+// don't match the data show up as "?".
+std::string row(Blurses::Buffer &buffer, uint16_t width, uint16_t y = 0) {
+	std::string text;
+
+	for (uint16_t x = 0; x < width; x++) {
+		const Blurses::Cell &cell = buffer.get(x, y);
+
+		if (cell.isContinuation()) {
+			text += x > 0 && buffer.get(x - 1, y).isWide() ? "~" : "?";
+		} else if (cell.isWide() && (x + 1 == width || !buffer.get(x + 1, y).isContinuation())) {
+			text += "?";
+		} else {
+			text += cell.data;
+		}
+	}
+
+	return text;
+}
+
+Blurses::Cell cell(const char* data, uint8_t width = 1) {
+	Blurses::Cell cell;
+	cell.data = data;
+	cell.width = width;
+	return cell;
+}
+
+// Writes that land on half of a wide character blank the other half, and
+// wide characters that don't fit are blanked, for Buffer::set and for
+// every Span write.
+void testWideCells() {
+	const Blurses::Cell wide = cell("日", 2);
+	QuietStdout quiet;
+
+	Blurses::Buffer buffer(6, 1);
+	buffer.span(0, 0, 5).fill(cell("."));
+	buffer.set(1, 0, wide);
+	buffer.set(3, 0, wide);
+	check(row(buffer, 6) == ".日~日~.", "buffer set wide");
+	buffer.set(1, 0, cell("a"));
+	buffer.set(4, 0, cell("b"));
+	check(row(buffer, 6) == ".a  b.", "buffer set over either half");
+	buffer.set(5, 0, wide);
+	check(row(buffer, 6) == ".a  b ", "buffer set wide in the last column");
+
+	Blurses::Buffer spans(8, 1);
+	spans.span(0, 0, 7).fill(cell("."));
+	spans.span(0, 0, 7).copy(std::vector<Blurses::Cell>({cell("a"), wide, wide, cell("b")}).data(), 4);
+	check(row(spans, 8) == "a日~日~b..", "span copy");
+	spans.span(0, 2, 3).set(0, cell("c"));
+	spans.span(0, 5, 5).set(0, wide);
+	check(row(spans, 8) == "a c日~ ..", "span set over either half, wide at the span end");
+	spans.span(0, 2, 4).fill(cell("f"));
+	check(row(spans, 8) == "a fff ..", "span fill over half of a wide cell");
+
+	spans.span(0, 0, 7).copy(std::vector<Blurses::Cell>({wide, wide, wide, wide}).data(), 4);
+	spans.span(0, 1, 4).fill(cell("-"));
+	check(row(spans, 8) == " ---- 日~", "span fill cuts wide cells at both ends");
+
+	// Cells laid out as a row, starting on a continuation and ending on a
+	// wide cell whose continuation is outside the span.
+	Blurses::Cell continuation = wide;
+	continuation.data.clear();
+	continuation.width = 0;
+	const std::vector<Blurses::Cell> cells({continuation, cell("x"), wide, continuation, wide});
+	spans.span(0, 0, 7).copy(std::vector<Blurses::Cell>({wide, wide, wide, wide}).data(), 4);
+	spans.span(0, 1, 5).assign(cells.data());
+	check(row(spans, 8) == "  x日~ 日~", "span assign blanks wide cells cut by either end");
+	check(row(spans, 8).find('?') == std::string::npos, "span assign leaves no orphaned halves");
+}
+
+// Changed cells next to half of a wide character print the whole
+// character, so the cursor skips to where the next range expects it.
+void testTaintedWideRanges() {
+	auto print = [](Blurses::Buffer &buffer) {
+		std::ostringstream output;
+		std::streambuf* saved = std::cout.rdbuf(output.rdbuf());
+		buffer.print(false);
+		std::cout.rdbuf(saved);
+		return output.str();
+	};
+
+	// Column skips in the printed rows.
+	auto skips = [](const std::string &output) {
+		std::vector<int> skips;
+
+		for (size_t i = output.find("\033["); i != std::string::npos; i = output.find("\033[", i + 1)) {
+			const size_t end = output.find_first_not_of("0123456789", i + 2);
+
+			if (end != std::string::npos && end > i + 2 && output[end] == 'C') {
+				skips.push_back(std::stoi(output.substr(i + 2, end - i - 2)));
+			}
+		}
+
+		return skips;
+	};
+
+	QuietStdout quiet;
+	Blurses::Buffer buffer(16, 1);
+
+	auto frame = [&](int changed) {
+		buffer.span(0, 0, 15).fill(cell("."));
+		buffer.set(4, 0, cell("日", 2));
+
+		if (changed >= 0) {
+			buffer.get(changed, 0).isUnderline = true;
+			buffer.get(12, 0).isUnderline = true;
+		}
+	};
+
+	frame(-1);
+	print(buffer);
+	frame(-1);
+	print(buffer);
+
+	// Only the continuation changed: the range starts at the wide cell.
+	frame(5);
+	std::string output = print(buffer);
+	check(output.find("日") != std::string::npos && skips(output) == std::vector<int>({4, 6}), "tainted range widened over a wide cell");
+
+	// Only the wide cell changed: the range ends after its continuation.
+	frame(-1);
+	print(buffer);
+	frame(4);
+	output = print(buffer);
+	check(output.find("日") != std::string::npos && skips(output) == std::vector<int>({4, 6}), "tainted range widened over a continuation");
+}
+
+// Culling and row-ordered painting must leave the same cells as drawing
+// every command right away, in recording order.
+void testDisplayList() {
+	const int width = 30;
+	const int height = 12;
+	const char* texts[] = {"hello", "日本", "a日b", "xy"};
+	std::mt19937 rng(9);
+	auto coordinate = [&](int size) { return int(rng() % (size + 20)) - 10; };
+
+	Blurses::BrailleBuffer pixels(12, 8);
+
+	for (int i = 0; i < 40; i++) {
+		pixels.set(rng() % 12, rng() % 8, true);
+	}
+
+	QuietStdout quiet;
+	Blurses::Display listed;
+	Blurses::Display immediate;
+	listed.resize(width, height);
+	immediate.resize(width, height);
+	Blurses::DisplayList list;
+	bool same = true;
+	size_t culled = 0;
+
+	for (int round = 0; round < 3000; round++) {
+		list.clear();
+		immediate.primitives().filledRect(0, 0, width - 1, height - 1, immediate.attr());
+		listed.primitives().filledRect(0, 0, width - 1, height - 1, listed.attr());
+
+		for (int i = rng() % 12; i >= 0; i--) {
+			Blurses::CellAttributes attrs = immediate.attr();
+			attrs.fg(Blurses::Color(rng() % 256, rng() % 256, rng() % 256));
+
+			if (rng() % 2) {
+				attrs.bg(Blurses::Color(rng() % 256, rng() % 256, rng() % 256));
+			}
+
+			const int x0 = coordinate(width), y0 = coordinate(height);
+			const int x1 = coordinate(width), y1 = coordinate(height);
+
+			switch (rng() % 5) {
+				case 0: {
+					const char* text = texts[rng() % 4];
+					list.text(x0, y0, text, attrs);
+					immediate.primitives().text(x0, y0, text, attrs);
+					break;
+				}
+				case 1:
+					list.rect(x0, y0, x1, y1, attrs);
+					immediate.primitives().rect(x0, y0, x1, y1, attrs);
+					break;
+				case 2:
+					list.filledRect(x0, y0, x1, y1, attrs);
+					immediate.primitives().filledRect(x0, y0, x1, y1, attrs);
+					break;
+				case 3:
+					list.line(x0, y0, x1, y1, attrs);
+					immediate.primitives().line(x0, y0, x1, y1, attrs);
+					break;
+				case 4: {
+					const int x = rng() % width, y = rng() % height;
+					list.braille(x, y, pixels, attrs);
+					pixels.draw(immediate, x, y, attrs);
+					break;
+				}
+			}
+		}
+
+		list.paint(listed);
+		culled += list.culled();
+
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				same = same && listed.get(x, y) == immediate.get(x, y);
+			}
+		}
+	}
+
+	check(same, "display list paints the same cells as immediate drawing");
+	check(culled > 0, "display list culls covered commands");
+}
+
+// Positional access through the checkpoint index against scanning from
+// the start of the string, which is what find_offset did without it.
+void benchmarkUtfstringIndex() {
+	using Blurses::utfstring;
+
+	std::string text;
+
+	while (text.size() < 8192) {
+		text += "håll ö 日本語 e\xcc\x81 abc ";
+	}
+
+	const utfstring str(text);
+	const size_t length = str.length();
+	const size_t lookups = 20000;
+	std::mt19937 rng(34);
+	std::vector<size_t> positions(lookups);
+
+	for (size_t &position : positions) {
+		position = rng() % length;
+	}
+
+	size_t linear_sum = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t position : positions) {
+		size_t i = 0;
+
+		for (const utfstring::grapheme &ch : str.graphemes()) {
+			if (i++ == position) {
+				linear_sum += ch.data - str.data();
+				break;
+			}
+		}
+	}
+
+	const double linear = seconds(start);
+
+	size_t indexed_sum = 0;
+	start = std::chrono::steady_clock::now();
+
+	for (size_t position : positions) {
+		indexed_sum += str.find_offset(position);
+	}
+
+	const double indexed = seconds(start);
+
+	check(linear_sum == indexed_sum, "utfstring index offsets");
+	std::cout << "utfstring find_offset on " << text.size() << " bytes: linear " << linear / lookups * 1e9 << " ns, indexed " << indexed / lookups * 1e9 << " ns" << std::endl;
+}
+
+// Lines and circles with the plotter inlined, against the same plotter
+// called through the std::function overloads.
+void benchmarkGraphics() {
+	const int size = 256;
+	std::vector<uint8_t> pixels(size * size);
+	auto plot = [&](int x, int y) {
+		if (x >= 0 && y >= 0 && x < size && y < size) {
+			pixels[y * size + x]++;
+		}
+	};
+	const Graphics::callback_func function = plot;
+	const int rounds = 2000;
+
+	auto draw = [&](auto &&fn) {
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < rounds; i++) {
+			Graphics::bresenham(0, i % size, size - 1, size - 1 - i % size, fn);
+			Graphics::bresenham(i % size, 0, size - 1 - i % size, size - 1, fn);
+			Graphics::circle(size / 2, size / 2, i % (size / 2), 0, fn, 1.0);
+		}
+
+		return seconds(start);
+	};
+
+	const double inlined = draw(plot);
+	const size_t inlined_sum = std::accumulate(pixels.begin(), pixels.end(), size_t(0));
+	std::fill(pixels.begin(), pixels.end(), 0);
+	const double indirect = draw(function);
+	const size_t indirect_sum = std::accumulate(pixels.begin(), pixels.end(), size_t(0));
+
+	check(inlined_sum == indirect_sum, "graphics plotters draw the same pixels");
+	std::cout << "graphics: template " << inlined * 1e3 << " ms, std::function " << indirect * 1e3 << " ms" << std::endl;
+}
+
+// Pipes generated 320x240 PPM frames through a VideoPlayer sized to the
+// terminal, drawing for as long as it plays.
+void playVideo(float fps, int frames) {
+	int fds[2];
+
+	if (pipe(fds) != 0) {
+		check(false, "video pipe");
+		return;
+	}
+
+	std::thread writer([&]() {
+		const std::string header = "P6\n320 240\n255\n";
+		std::string frame = header + std::string(320 * 240 * 3, '\0');
+
+		for (int i = 0; i < frames; i++) {
+			for (size_t j = header.size(); j < frame.size(); j++) {
+				frame[j] = j + i * 7;
+			}
+
+			for (size_t written = 0; written < frame.size(); ) {
+				const ssize_t length = write(fds[1], frame.data() + written, frame.size() - written);
+
+				if (length <= 0) {
+					break;
+				}
+
+				written += length;
+			}
+		}
+
+		close(fds[1]);
+	});
+
+	size_t decoded, shown, dropped;
+	double elapsed;
+
+	{
+		QuietStdout quiet;
+		Blurses::Display display;
+		display.update();
+
+		Blurses::VideoPlayer player(display, fds[0], display.width(), display.height(), fps);
+		const auto start = std::chrono::steady_clock::now();
+		player.start();
+
+		while (!player.finished()) {
+			player.draw(display, 0, 0);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		elapsed = seconds(start);
+		player.stop();
+		decoded = player.decoded();
+		shown = player.shown();
+		dropped = player.dropped();
+	}
+
+	writer.join();
+	close(fds[0]);
+
+	check(decoded == size_t(frames), "video reads every frame");
+	check(shown + dropped == decoded, "video shows or drops every frame");
+	std::cout << "video at " << fps << " fps: " << shown / elapsed << " frames/s shown, " << dropped << " of " << decoded << " dropped" << std::endl;
+}
+
+void benchmarkVideo() {
+	if (!isatty(STDOUT_FILENO)) {
+		std::cout << "video: skipped, stdout is not a terminal" << std::endl;
+		return;
+	}
+
+	playVideo(1000, 200);
+	playVideo(30, 30);
+}
+
+// A lit sphere of 32 x 16 quads, turned a little every frame.
+void benchmarkRenderer() {
+	const int slices = 32;
+	const int stacks = 16;
+	Blurses::Mesh sphere;
+	sphere.reserve((slices + 1) * (stacks + 1), slices * stacks * 2);
+
+	for (int stack = 0; stack <= stacks; stack++) {
+		for (int slice = 0; slice <= slices; slice++) {
+			const float theta = M_PI * stack / stacks;
+			const float phi = 2 * M_PI * slice / slices;
+			const glm::vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+			sphere.addVertex(normal, glm::vec3(1.0f, 0.5f, 0.25f), normal);
+		}
+	}
+
+	for (int stack = 0; stack < stacks; stack++) {
+		for (int slice = 0; slice < slices; slice++) {
+			const uint32_t i = stack * (slices + 1) + slice;
+			sphere.addTriangle(i, i + 1, i + slices + 1);
+			sphere.addTriangle(i + 1, i + slices + 2, i + slices + 1);
+		}
+	}
+
+	Blurses::Light light;
+	light.ambient = glm::vec3(1.0f, 1.0f, 1.0f);
+	light.ambientIntensity = 0.2f;
+	light.diffuse = glm::vec3(1.0f, 1.0f, 1.0f);
+	light.diffuseIntensity = 0.8f;
+	light.direction = glm::vec3(0.0f, 0.0f, 1.0f);
+
+	const int frames = 500;
+	double elapsed;
+	bool center, corner;
+
+	{
+		QuietStdout quiet;
+		Blurses::Display display;
+		display.resize(120, 40);
+		Blurses::Renderer renderer;
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int frame = 0; frame < frames; frame++) {
+			const float angle = frame * 0.01f;
+			glm::mat4 transform(1.0f);
+			transform[0][0] = 18.0f * std::cos(angle);
+			transform[0][2] = 18.0f * std::sin(angle);
+			transform[1][1] = 18.0f;
+			transform[2][0] = -18.0f * std::sin(angle);
+			transform[2][2] = 18.0f * std::cos(angle);
+
+			renderer.clear(display);
+			renderer.draw(display, sphere, transform, light);
+		}
+
+		elapsed = seconds(start);
+		center = display.get(60, 20).bg != Blurses::Cell().bg;
+		corner = display.get(0, 0).bg == Blurses::Cell().bg;
+	}
+
+	check(center && corner, "renderer fills the sphere and nothing around it");
+	std::cout << "renderer: " << sphere.triangleCount() << " triangles on 120x40 in " << elapsed / frames * 1e6 << " us per frame" << std::endl;
+}
+
+// Labels drawn every frame through Primitives::text, which caches them,
+// against the uncached grapheme path. Both the same labels every frame and
+// labels that change every frame.
+void benchmarkTextCache() {
+	const int frames = 2000;
+	const int labels = 40;
+	std::vector<Blurses::utfstring> repeated;
+
+	for (int i = 0; i < labels; i++) {
+		repeated.push_back("label " + std::to_string(i) + ": ÅÄÖ 日本 value");
+	}
+
+	double repeated_cached, repeated_direct, unique_cached, unique_direct;
+	size_t hits, entries, unique_entries;
+	bool same = true;
+
+	{
+		QuietStdout quiet;
+		Blurses::Display cached;
+		Blurses::Display direct;
+		cached.resize(120, labels);
+		direct.resize(120, labels);
+		const Blurses::CellAttributes attrs = cached.attr().fg(Blurses::Color(255, 200, 0));
+
+		auto run = [&](Blurses::Display &display, bool cache, bool unique) {
+			const auto start = std::chrono::steady_clock::now();
+
+			auto draw = [&](int y, const Blurses::utfstring &text) {
+				if (cache) {
+					display.primitives().text(2, y, text, attrs);
+				} else {
+					display.primitives().text(2, y, text.graphemes(), attrs);
+				}
+			};
+
+			for (int frame = 0; frame < frames; frame++) {
+				for (int i = 0; i < labels; i++) {
+					if (unique) {
+						draw(i, "frame " + std::to_string(frame * labels + i) + " 日本");
+					} else {
+						draw(i, repeated[i]);
+					}
+				}
+			}
+
+			return seconds(start) / frames * 1e6;
+		};
+
+		repeated_cached = run(cached, true, false);
+		repeated_direct = run(direct, false, false);
+
+		for (int y = 0; y < labels; y++) {
+			for (int x = 0; x < 120; x++) {
+				same = same && cached.get(x, y) == direct.get(x, y);
+			}
+		}
+
+		const Blurses::TextCache &cache = cached.primitives().textCache();
+		hits = cache.hits();
+		entries = cache.size();
+		unique_cached = run(cached, true, true);
+		unique_direct = run(direct, false, true);
+		unique_entries = cache.size();
+	}
+
+	check(same, "cached text draws the same cells");
+	check(hits == size_t(frames - 2) * labels && entries == size_t(labels), "repeated labels are cached on their second draw");
+	check(unique_entries == entries, "text drawn once is not cached");
+	std::cout << "text cache, us per frame of " << labels << " labels: repeated " << repeated_cached << " cached, " << repeated_direct << " direct; unique " << unique_cached << " cached, " << unique_direct << " direct" << std::endl;
+}
+
+void benchmarkInputParser() {
+	std::mt19937 rng(1);
+	const std::string input = randomInput(rng, 1 << 18);
+	const size_t chunk = 4096;
+	const int rounds = 8;
+
+	CountingSink sink;
+	Blurses::InputParser<CountingSink> parser(sink);
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int round = 0; round < rounds; round++) {
+		for (size_t i = 0; i < input.size(); i += chunk) {
+			parser.feed(input.data() + i, std::min(chunk, input.size() - i));
+		}
+	}
+
+	const double elapsed = seconds(start);
+	std::cout << "input parser: " << input.size() * rounds / elapsed / 1e6 << " MB/s (" << sink.count << " events)" << std::endl;
+}
+}
 
 bool isCombining(int cp) {
 	return (
@@ -11,7 +1056,7 @@ bool isCombining(int cp) {
    );
 }
 
-int test() {
+void utfstringExamples() {
 	using Blurses::utfstring;
 
 	/*
@@ -53,6 +1098,29 @@ int test() {
 			break;
 		}
 	}
+}
+
+int test() {
+	utfstringExamples();
+	testInputParserSplits();
+	testMouseWheel();
+	testLongGrapheme();
+	testUnicodeWidth();
+	testRingBufferClose();
+	testBrailleChart();
+	testDisplayList();
+	testClippedLines();
+	testTextLayoutWidths();
+	testSimdUtf8();
+	testWideCells();
+	testTaintedWideRanges();
+	benchmarkInputParser();
+	benchmarkUtfstringIndex();
+	benchmarkGraphics();
+	benchmarkVideo();
+	benchmarkRenderer();
+	benchmarkTextCache();
 
-	return 0;
+	std::cout << (failures ? "FAILED" : "OK") << std::endl;
+	return failures;
 }
@@ -1,4 +1,7 @@
 #ifndef TEST_HPP
 #define TEST_HPP
 
+// Runs the checks and benchmarks in test.cpp, returns the number of failures.
+int test();
+
 #endif
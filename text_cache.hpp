@@ -0,0 +1,130 @@
+#ifndef TEXT_CACHE_HPP
+#define TEXT_CACHE_HPP
+
+#include <list>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include "cell.hpp"
+#include "cell_attributes.hpp"
+#include "utfstring.hpp"
+
+namespace Blurses {
+// LRU cache of strings drawn with Primitives::text, segmented into cells
+// with the attributes applied. Lookups don't allocate. A string is only
+// cached the second time it's seen, so text that changes every frame
+// costs a hash and no allocation.
+class TextCache {
+	public:
+		struct Entry {
+			Entry(const utfstring &text, const CellAttributes &attrs)
+				: text(text.data(), text.size())
+				, attrs(attrs)
+				, hash(TextCache::hash(text, attrs)) {
+				for (const utfstring::grapheme &ch : text.graphemes()) {
+					Cell cell(attrs.buildCell());
+					cell.data.assign(ch.data, ch.size);
+					cell.width = ch.width;
+					cells.push_back(cell);
+				}
+			}
+
+			const std::string text;
+			const CellAttributes attrs;
+			const size_t hash;
+			std::vector<Cell> cells;
+		};
+
+		TextCache(size_t maxEntries = 256, size_t maxLength = 512)
+			: _max_entries(maxEntries)
+			, _max_length(maxLength)
+			, _hits(0)
+			, _misses(0)
+			, _seen(maxEntries * 2, 0) { }
+
+		// Returns nullptr for strings too long to be cached, and for strings
+		// not seen recently.
+		const Entry* get(const utfstring &text, const CellAttributes &attrs) {
+			if (text.size() > _max_length || _max_entries == 0) {
+				return nullptr;
+			}
+
+			const size_t key = hash(text, attrs);
+			auto found = _index.find(key);
+
+			if (found != _index.end()) {
+				const Entry &entry = *found->second;
+
+				if (entry.text.compare(0, std::string::npos, text.data(), text.size()) == 0 && entry.attrs == attrs) {
+					_hits++;
+					_entries.splice(_entries.begin(), _entries, found->second);
+					return &entry;
+				}
+
+				// Hash collision, the new string replaces the old one.
+				_entries.erase(found->second);
+				_index.erase(found);
+			}
+
+			_misses++;
+
+			// Recently seen hashes, one per slot, newer ones replacing older.
+			size_t &seen = _seen[key % _seen.size()];
+
+			if (seen != key) {
+				seen = key;
+				return nullptr;
+			}
+
+			if (_entries.size() >= _max_entries) {
+				_index.erase(_entries.back().hash);
+				_entries.pop_back();
+			}
+
+			_entries.emplace_front(text, attrs);
+			_index[key] = _entries.begin();
+			return &_entries.front();
+		}
+
+		void clear() {
+			_entries.clear();
+			_index.clear();
+			std::fill(_seen.begin(), _seen.end(), 0);
+		}
+
+		size_t hits() const {
+			return _hits;
+		}
+
+		size_t misses() const {
+			return _misses;
+		}
+
+		size_t size() const {
+			return _entries.size();
+		}
+
+	private:
+		const size_t _max_entries;
+		const size_t _max_length;
+		size_t _hits;
+		size_t _misses;
+		std::list<Entry> _entries;
+		std::unordered_map<size_t, std::list<Entry>::iterator> _index;
+		std::vector<size_t> _seen;
+
+		static size_t hash(const utfstring &text, const CellAttributes &attrs) {
+			// FNV-1a
+			size_t value = 14695981039346656037ULL;
+
+			for (size_t i = 0; i < text.size(); i++) {
+				value ^= static_cast<uint8_t>(text.data()[i]);
+				value *= 1099511628211ULL;
+			}
+
+			return value ^ (attrs.hash() * 0x9e3779b97f4a7c15ULL);
+		}
+};
+};
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef TEXT_LAYOUT_HPP
+#define TEXT_LAYOUT_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "display.hpp"
+#include "utfstring.hpp"
+
+namespace Blurses {
+// Word-wrapped text, laid out once per paragraph and width. Appending only
+// lays out the new text, and a width change reflows each paragraph once.
+// The last few widths keep their lines, so switching back doesn't reflow.
+class TextLayout {
+	public:
+		static const size_t MAX_WIDTHS = 4;
+
+		struct Line {
+			uint32_t offset;
+			uint32_t size;
+		};
+
+		TextLayout(uint16_t width = 80) {
+			_layouts.push_back(Layout(std::max<uint16_t>(width, 1)));
+		}
+
+		// Adds one paragraph per line of text.
+		void append(const utfstring &text) {
+			const char* start = text.data();
+			const char* end = start + text.size();
+
+			while (true) {
+				const char* newline = std::find(start, end, '\n');
+
+				_paragraphs.push_back(std::string(start, newline));
+
+				if (newline == end) {
+					break;
+				}
+
+				start = newline + 1;
+			}
+
+			update();
+		}
+
+		// Continues the last paragraph, reflowing only that one.
+		void extend(const utfstring &text) {
+			if (_paragraphs.empty()) {
+				append(text);
+				return;
+			}
+
+			const char* start = text.data();
+			const char* end = start + text.size();
+			const char* newline = std::find(start, end, '\n');
+
+			// Widths not in use lay the paragraph out again when selected.
+			for (Layout &layout : _layouts) {
+				if (layout.lines.size() == _paragraphs.size()) {
+					layout.line_count -= layout.lines.back().size();
+					layout.lines.pop_back();
+					layout.first_line.pop_back();
+				}
+			}
+
+			_paragraphs.back().append(start, newline);
+			update();
+
+			if (newline != end) {
+				append(std::string(newline + 1, end));
+			}
+		}
+
+		void setWidth(uint16_t width) {
+			width = std::max<uint16_t>(width, 1);
+
+			auto it = std::find_if(_layouts.begin(), _layouts.end(), [&](const Layout &layout) {
+				return layout.width == width;
+			});
+
+			if (it != _layouts.end()) {
+				std::rotate(_layouts.begin(), it, it + 1);
+			} else {
+				if (_layouts.size() >= MAX_WIDTHS) {
+					_layouts.pop_back();
+				}
+
+				_layouts.insert(_layouts.begin(), Layout(width));
+			}
+
+			update();
+		}
+
+		uint16_t width() const {
+			return _layouts.front().width;
+		}
+
+		size_t lineCount() const {
+			return _layouts.front().line_count;
+		}
+
+		size_t paragraphCount() const {
+			return _paragraphs.size();
+		}
+
+		void clear() {
+			_paragraphs.clear();
+			_layouts.erase(_layouts.begin() + 1, _layouts.end());
+			_layouts.front() = Layout(_layouts.front().width);
+		}
+
+		utfstring::grapheme_range line(size_t index) const {
+			const Layout &layout = _layouts.front();
+			const size_t paragraph = paragraphAt(index);
+			const Line &line = layout.lines[paragraph][index - layout.first_line[paragraph]];
+			const char* start = _paragraphs[paragraph].data() + line.offset;
+
+			return utfstring::grapheme_range(start, start + line.size);
+		}
+
+		// Draws at most height lines, starting from firstLine.
+		void draw(Display &display, uint16_t x, uint16_t y, uint16_t height, size_t firstLine, const CellAttributes &attrs) const {
+			const Layout &layout = _layouts.front();
+
+			if (firstLine >= layout.line_count) {
+				return;
+			}
+
+			size_t paragraph = paragraphAt(firstLine);
+			size_t index = firstLine - layout.first_line[paragraph];
+
+			for (uint16_t row = 0; row < height && paragraph < _paragraphs.size(); row++) {
+				const std::vector<Line> &lines = layout.lines[paragraph];
+				const Line &line = lines[index];
+				const char* start = _paragraphs[paragraph].data() + line.offset;
+
+				display.primitives().text(x, y + row, utfstring::grapheme_range(start, start + line.size), attrs);
+
+				if (++index == lines.size()) {
+					index = 0;
+					paragraph++;
+				}
+			}
+		}
+
+	private:
+		// The lines of every paragraph at one width.
+		struct Layout {
+			Layout(uint16_t width)
+				: width(width)
+				, line_count(0) { }
+
+			uint16_t width;
+			size_t line_count;
+			std::vector<std::vector<Line> > lines;
+			std::vector<size_t> first_line;
+		};
+
+		std::vector<std::string> _paragraphs;
+		// Most recently used first. Only the first one is kept up to date.
+		std::vector<Layout> _layouts;
+
+		size_t paragraphAt(size_t line) const {
+			const std::vector<size_t> &first_line = _layouts.front().first_line;
+			return std::upper_bound(first_line.begin(), first_line.end(), line) - first_line.begin() - 1;
+		}
+
+		// Lays out the paragraphs the current width hasn't seen yet.
+		void update() {
+			Layout &layout = _layouts.front();
+
+			while (layout.lines.size() < _paragraphs.size()) {
+				layout.first_line.push_back(layout.line_count);
+				layout.lines.push_back(breakLines(_paragraphs[layout.lines.size()], layout.width));
+				layout.line_count += layout.lines.back().size();
+			}
+		}
+
+		// Breaks after whitespace when possible, otherwise inside the word.
+		// Whitespace at a break is left out of both lines.
+		static std::vector<Line> breakLines(const std::string &text, uint16_t maxWidth) {
+			const char* start = text.data();
+			const char* end = start + text.size();
+			const char* line = start;
+			const char* word_end = nullptr;
+			const char* word_start = nullptr;
+			int column = 0;
+			int word_column = 0;
+			std::vector<Line> lines;
+
+			auto emit = [&](const char* from, const char* to) {
+				lines.push_back({
+					static_cast<uint32_t>(from - start),
+					static_cast<uint32_t>(to - from)
+				});
+			};
+
+			for (const char* curr = start; curr != end;) {
+				uint8_t width;
+				const char* next = utfstring::next_grapheme(curr, end, &width);
+
+				if (*curr == ' ') {
+					if (curr != line && (!word_end || word_start)) {
+						word_end = curr;
+						word_start = nullptr;
+					}
+
+					column = std::min<int>(column + width, maxWidth);
+					curr = next;
+					continue;
+				}
+
+				if (word_end && !word_start) {
+					word_start = curr;
+					word_column = column;
+				}
+
+				if (column + width > maxWidth && curr != line) {
+					if (word_start) {
+						emit(line, word_end);
+						line = word_start;
+						column -= word_column;
+					} else {
+						emit(line, curr);
+						line = curr;
+						column = 0;
+					}
+
+					word_end = nullptr;
+					word_start = nullptr;
+				}
+
+				column += width;
+				curr = next;
+			}
+
+			emit(line, end);
+
+			return lines;
+		}
+};
+};
+
+#endif
@@ -7,7 +7,9 @@
 namespace Blurses {
 class Timer {
 	public:
-		Timer() : _start_at(std::chrono::system_clock::now()) { }
+		Timer(unsigned long frameInterval = 50)
+			: _start_at(std::chrono::system_clock::now())
+			, _frame_interval(frameInterval) { }
 
 		unsigned long getTime() {
 			auto now = std::chrono::system_clock::now();
@@ -15,11 +17,12 @@ class Timer {
 		}
 
 		void update() const {
-			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			std::this_thread::sleep_for(std::chrono::milliseconds(_frame_interval));
 		}
 
 	private:
 		std::chrono::time_point<std::chrono::system_clock> _start_at;
+		const unsigned long _frame_interval;
 };
 };
 
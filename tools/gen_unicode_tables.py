@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Generates unicode_tables.hpp from Python's unicodedata.
+
+    python3 tools/gen_unicode_tables.py > unicode_tables.hpp
+"""
+
+import unicodedata
+
+# Grapheme cluster break properties, must match Unicode::BREAK in unicode.hpp.
+OTHER, CR, LF, CONTROL, EXTEND, ZWJ, SPACING_MARK, REGIONAL_INDICATOR, PICTOGRAPHIC = range(9)
+BREAK_NAMES = [
+    "BREAK_OTHER", "BREAK_CR", "BREAK_LF", "BREAK_CONTROL", "BREAK_EXTEND",
+    "BREAK_ZWJ", "BREAK_SPACING_MARK", "BREAK_REGIONAL_INDICATOR", "BREAK_PICTOGRAPHIC",
+]
+
+# unicodedata has no Extended_Pictographic, these are the emoji blocks.
+PICTOGRAPHIC_RANGES = [
+    (0x00A9, 0x00A9), (0x00AE, 0x00AE), (0x203C, 0x203C), (0x2049, 0x2049),
+    (0x2122, 0x2122), (0x2139, 0x2139), (0x2194, 0x2199), (0x21A9, 0x21AA),
+    (0x231A, 0x231B), (0x2328, 0x2328), (0x23CF, 0x23CF), (0x23E9, 0x23F3),
+    (0x23F8, 0x23FA), (0x24C2, 0x24C2), (0x25AA, 0x25AB), (0x25B6, 0x25B6),
+    (0x25C0, 0x25C0), (0x25FB, 0x25FE), (0x2600, 0x27BF), (0x2934, 0x2935),
+    (0x2B05, 0x2B07), (0x2B1B, 0x2B1C), (0x2B50, 0x2B50), (0x2B55, 0x2B55),
+    (0x3030, 0x3030), (0x303D, 0x303D), (0x3297, 0x3297), (0x3299, 0x3299),
+    (0x1F000, 0x1F0FF), (0x1F10D, 0x1F10F), (0x1F12F, 0x1F12F), (0x1F16C, 0x1F171),
+    (0x1F17E, 0x1F17F), (0x1F18E, 0x1F18E), (0x1F191, 0x1F19A), (0x1F1AD, 0x1F1E5),
+    (0x1F201, 0x1F20F), (0x1F21A, 0x1F21A), (0x1F22F, 0x1F22F), (0x1F232, 0x1F23A),
+    (0x1F23C, 0x1F23F), (0x1F249, 0x1F3FA), (0x1F400, 0x1F53D), (0x1F546, 0x1F64F),
+    (0x1F680, 0x1F6FF), (0x1F774, 0x1F77F), (0x1F7D5, 0x1F7FF), (0x1F80C, 0x1F80F),
+    (0x1F848, 0x1F84F), (0x1F85A, 0x1F85F), (0x1F888, 0x1F88F), (0x1F8AE, 0x1F8FF),
+    (0x1F90C, 0x1F93A), (0x1F93C, 0x1F945), (0x1F947, 0x1FAFF), (0x1FC00, 0x1FFFD),
+]
+
+
+def in_ranges(cp, ranges):
+    return any(first <= cp <= last for first, last in ranges)
+
+
+def grapheme_break(cp):
+    if cp == 0x0D:
+        return CR
+    if cp == 0x0A:
+        return LF
+    if cp == 0x200D:
+        return ZWJ
+    if 0x1F1E6 <= cp <= 0x1F1FF:
+        return REGIONAL_INDICATOR
+    if 0x1F3FB <= cp <= 0x1F3FF or 0xE0020 <= cp <= 0xE007F or cp in (0x200C, 0xFF9E, 0xFF9F):
+        return EXTEND
+    if in_ranges(cp, PICTOGRAPHIC_RANGES):
+        return PICTOGRAPHIC
+
+    category = unicodedata.category(chr(cp))
+
+    if category in ("Mn", "Me"):
+        return EXTEND
+    if category == "Mc":
+        return SPACING_MARK
+    if category in ("Cc", "Cf", "Zl", "Zp"):
+        return CONTROL
+    return OTHER
+
+
+def width(cp):
+    category = unicodedata.category(chr(cp))
+    wide_plane = 0x20000 <= cp <= 0x2FFFD or 0x30000 <= cp <= 0x3FFFD
+
+    if category == "Cn" and not wide_plane:
+        # Unassigned codepoints and noncharacters, which east_asian_width
+        # reports as F. Terminals advance them one column.
+        return 1
+    if category in ("Mn", "Me") or cp == 0x200B or (category == "Cf" and cp != 0x00AD):
+        return 0
+    if 0x1160 <= cp <= 0x11FF:
+        return 0
+    if 0x1F1E6 <= cp <= 0x1F1FF:
+        # Regional indicators are shown as wide flags in pairs.
+        return 2
+    if unicodedata.east_asian_width(chr(cp)) in ("W", "F"):
+        return 2
+    if wide_plane:
+        return 2
+    return 1
+
+
+def main():
+    ranges = []
+
+    for cp in range(0x110000):
+        if 0xD800 <= cp <= 0xDFFF:
+            continue
+
+        value = (width(cp), grapheme_break(cp))
+
+        if value == (1, OTHER):
+            continue
+
+        if ranges and ranges[-1][1] == cp - 1 and ranges[-1][2] == value:
+            ranges[-1][1] = cp
+        else:
+            ranges.append([cp, cp, value])
+
+    print("// Generated by tools/gen_unicode_tables.py from Unicode %s, do not edit." % unicodedata.unidata_version)
+    print("#ifndef UNICODE_TABLES_HPP")
+    print("#define UNICODE_TABLES_HPP")
+    print()
+    print("#include <cstddef>")
+    print("#include <cstdint>")
+    print()
+    print("namespace Blurses {")
+    print("namespace Unicode {")
+    print("enum BREAK {")
+    for name in BREAK_NAMES:
+        print("\t%s," % name)
+    print("};")
+    print()
+    print("struct Range {")
+    print("\tuint32_t first;")
+    print("\tuint32_t last;")
+    print("\tuint8_t width;")
+    print("\tuint8_t grapheme_break;")
+    print("};")
+    print()
+    print("// Codepoints that are not one column wide or have a grapheme break")
+    print("// property other than BREAK_OTHER, sorted by codepoint.")
+    print("const Range RANGES[] = {")
+    for first, last, (w, brk) in ranges:
+        print("\t{0x%05X, 0x%05X, %d, %s}," % (first, last, w, BREAK_NAMES[brk]))
+    print("};")
+    print()
+    print("const size_t RANGE_COUNT = sizeof RANGES / sizeof RANGES[0];")
+    print("};")
+    print("};")
+    print()
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
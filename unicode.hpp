@@ -0,0 +1,101 @@
+#ifndef UNICODE_HPP
+#define UNICODE_HPP
+
+#include <algorithm>
+#include "unicode_tables.hpp"
+
+namespace Blurses {
+namespace Unicode {
+	inline const Range* lookup(uint32_t cp) {
+		const Range *end = RANGES + RANGE_COUNT;
+		const Range *range = std::upper_bound(RANGES, end, cp, [](uint32_t value, const Range &r) {
+			return value < r.first;
+		});
+
+		if (range == RANGES || (range - 1)->last < cp) {
+			return nullptr;
+		}
+
+		return range - 1;
+	}
+
+	// Columns taken by cp in a terminal, 0 for combining marks and 2 for
+	// wide East Asian characters and emoji.
+	inline uint8_t width(uint32_t cp) {
+		if (cp >= 0x20 && cp < 0x300) {
+			return 1;
+		}
+
+		const Range *range = lookup(cp);
+		return range ? range->width : 1;
+	}
+
+	inline BREAK graphemeBreak(uint32_t cp) {
+		if (cp >= 0x20 && cp < 0x7f) {
+			return BREAK_OTHER;
+		}
+
+		const Range *range = lookup(cp);
+		return range ? static_cast<BREAK>(range->grapheme_break) : BREAK_OTHER;
+	}
+
+	// Extended grapheme cluster boundaries (UAX #29) for the properties in
+	// unicode_tables.hpp. Hangul jamo sequences and prepend marks are not
+	// handled.
+	class GraphemeBreaker {
+		public:
+			GraphemeBreaker() {
+				reset();
+			}
+
+			// Whether a new grapheme starts at cp, the first codepoint always does.
+			bool next(uint32_t cp) {
+				const BREAK curr = graphemeBreak(cp);
+				const bool result = isBreak(curr);
+
+				if (result) {
+					_pictographic = false;
+					_regional_count = 0;
+				}
+
+				if (curr == BREAK_PICTOGRAPHIC) {
+					_pictographic = true;
+				}
+
+				if (curr == BREAK_REGIONAL_INDICATOR) {
+					_regional_count++;
+				}
+
+				_prev = curr;
+				_first = false;
+				return result;
+			}
+
+			void reset() {
+				_first = true;
+				_prev = BREAK_OTHER;
+				_pictographic = false;
+				_regional_count = 0;
+			}
+
+		private:
+			bool _first;
+			BREAK _prev;
+			bool _pictographic;
+			uint8_t _regional_count;
+
+			bool isBreak(BREAK curr) const {
+				if (_first) { return true; }
+				if (_prev == BREAK_CR && curr == BREAK_LF) { return false; }
+				if (_prev == BREAK_CR || _prev == BREAK_LF || _prev == BREAK_CONTROL) { return true; }
+				if (curr == BREAK_CR || curr == BREAK_LF || curr == BREAK_CONTROL) { return true; }
+				if (curr == BREAK_EXTEND || curr == BREAK_ZWJ || curr == BREAK_SPACING_MARK) { return false; }
+				if (_prev == BREAK_ZWJ && curr == BREAK_PICTOGRAPHIC && _pictographic) { return false; }
+				if (_prev == BREAK_REGIONAL_INDICATOR && curr == BREAK_REGIONAL_INDICATOR) { return _regional_count % 2 == 0; }
+				return true;
+			}
+	};
+};
+};
+
+#endif
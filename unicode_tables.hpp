@@ -0,0 +1,822 @@
+// Generated by tools/gen_unicode_tables.py from Unicode 14.0.0, do not edit.
+#ifndef UNICODE_TABLES_HPP
+#define UNICODE_TABLES_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Blurses {
+namespace Unicode {
+enum BREAK {
+	BREAK_OTHER,
+	BREAK_CR,
+	BREAK_LF,
+	BREAK_CONTROL,
+	BREAK_EXTEND,
+	BREAK_ZWJ,
+	BREAK_SPACING_MARK,
+	BREAK_REGIONAL_INDICATOR,
+	BREAK_PICTOGRAPHIC,
+};
+
+struct Range {
+	uint32_t first;
+	uint32_t last;
+	uint8_t width;
+	uint8_t grapheme_break;
+};
+
+// Codepoints that are not one column wide or have a grapheme break
+// property other than BREAK_OTHER, sorted by codepoint.
+const Range RANGES[] = {
+	{0x00000, 0x00009, 1, BREAK_CONTROL},
+	{0x0000A, 0x0000A, 1, BREAK_LF},
+	{0x0000B, 0x0000C, 1, BREAK_CONTROL},
+	{0x0000D, 0x0000D, 1, BREAK_CR},
+	{0x0000E, 0x0001F, 1, BREAK_CONTROL},
+	{0x0007F, 0x0009F, 1, BREAK_CONTROL},
+	{0x000A9, 0x000A9, 1, BREAK_PICTOGRAPHIC},
+	{0x000AD, 0x000AD, 1, BREAK_CONTROL},
+	{0x000AE, 0x000AE, 1, BREAK_PICTOGRAPHIC},
+	{0x00300, 0x0036F, 0, BREAK_EXTEND},
+	{0x00483, 0x00489, 0, BREAK_EXTEND},
+	{0x00591, 0x005BD, 0, BREAK_EXTEND},
+	{0x005BF, 0x005BF, 0, BREAK_EXTEND},
+	{0x005C1, 0x005C2, 0, BREAK_EXTEND},
+	{0x005C4, 0x005C5, 0, BREAK_EXTEND},
+	{0x005C7, 0x005C7, 0, BREAK_EXTEND},
+	{0x00600, 0x00605, 0, BREAK_CONTROL},
+	{0x00610, 0x0061A, 0, BREAK_EXTEND},
+	{0x0061C, 0x0061C, 0, BREAK_CONTROL},
+	{0x0064B, 0x0065F, 0, BREAK_EXTEND},
+	{0x00670, 0x00670, 0, BREAK_EXTEND},
+	{0x006D6, 0x006DC, 0, BREAK_EXTEND},
+	{0x006DD, 0x006DD, 0, BREAK_CONTROL},
+	{0x006DF, 0x006E4, 0, BREAK_EXTEND},
+	{0x006E7, 0x006E8, 0, BREAK_EXTEND},
+	{0x006EA, 0x006ED, 0, BREAK_EXTEND},
+	{0x0070F, 0x0070F, 0, BREAK_CONTROL},
+	{0x00711, 0x00711, 0, BREAK_EXTEND},
+	{0x00730, 0x0074A, 0, BREAK_EXTEND},
+	{0x007A6, 0x007B0, 0, BREAK_EXTEND},
+	{0x007EB, 0x007F3, 0, BREAK_EXTEND},
+	{0x007FD, 0x007FD, 0, BREAK_EXTEND},
+	{0x00816, 0x00819, 0, BREAK_EXTEND},
+	{0x0081B, 0x00823, 0, BREAK_EXTEND},
+	{0x00825, 0x00827, 0, BREAK_EXTEND},
+	{0x00829, 0x0082D, 0, BREAK_EXTEND},
+	{0x00859, 0x0085B, 0, BREAK_EXTEND},
+	{0x00890, 0x00891, 0, BREAK_CONTROL},
+	{0x00898, 0x0089F, 0, BREAK_EXTEND},
+	{0x008CA, 0x008E1, 0, BREAK_EXTEND},
+	{0x008E2, 0x008E2, 0, BREAK_CONTROL},
+	{0x008E3, 0x00902, 0, BREAK_EXTEND},
+	{0x00903, 0x00903, 1, BREAK_SPACING_MARK},
+	{0x0093A, 0x0093A, 0, BREAK_EXTEND},
+	{0x0093B, 0x0093B, 1, BREAK_SPACING_MARK},
+	{0x0093C, 0x0093C, 0, BREAK_EXTEND},
+	{0x0093E, 0x00940, 1, BREAK_SPACING_MARK},
+	{0x00941, 0x00948, 0, BREAK_EXTEND},
+	{0x00949, 0x0094C, 1, BREAK_SPACING_MARK},
+	{0x0094D, 0x0094D, 0, BREAK_EXTEND},
+	{0x0094E, 0x0094F, 1, BREAK_SPACING_MARK},
+	{0x00951, 0x00957, 0, BREAK_EXTEND},
+	{0x00962, 0x00963, 0, BREAK_EXTEND},
+	{0x00981, 0x00981, 0, BREAK_EXTEND},
+	{0x00982, 0x00983, 1, BREAK_SPACING_MARK},
+	{0x009BC, 0x009BC, 0, BREAK_EXTEND},
+	{0x009BE, 0x009C0, 1, BREAK_SPACING_MARK},
+	{0x009C1, 0x009C4, 0, BREAK_EXTEND},
+	{0x009C7, 0x009C8, 1, BREAK_SPACING_MARK},
+	{0x009CB, 0x009CC, 1, BREAK_SPACING_MARK},
+	{0x009CD, 0x009CD, 0, BREAK_EXTEND},
+	{0x009D7, 0x009D7, 1, BREAK_SPACING_MARK},
+	{0x009E2, 0x009E3, 0, BREAK_EXTEND},
+	{0x009FE, 0x009FE, 0, BREAK_EXTEND},
+	{0x00A01, 0x00A02, 0, BREAK_EXTEND},
+	{0x00A03, 0x00A03, 1, BREAK_SPACING_MARK},
+	{0x00A3C, 0x00A3C, 0, BREAK_EXTEND},
+	{0x00A3E, 0x00A40, 1, BREAK_SPACING_MARK},
+	{0x00A41, 0x00A42, 0, BREAK_EXTEND},
+	{0x00A47, 0x00A48, 0, BREAK_EXTEND},
+	{0x00A4B, 0x00A4D, 0, BREAK_EXTEND},
+	{0x00A51, 0x00A51, 0, BREAK_EXTEND},
+	{0x00A70, 0x00A71, 0, BREAK_EXTEND},
+	{0x00A75, 0x00A75, 0, BREAK_EXTEND},
+	{0x00A81, 0x00A82, 0, BREAK_EXTEND},
+	{0x00A83, 0x00A83, 1, BREAK_SPACING_MARK},
+	{0x00ABC, 0x00ABC, 0, BREAK_EXTEND},
+	{0x00ABE, 0x00AC0, 1, BREAK_SPACING_MARK},
+	{0x00AC1, 0x00AC5, 0, BREAK_EXTEND},
+	{0x00AC7, 0x00AC8, 0, BREAK_EXTEND},
+	{0x00AC9, 0x00AC9, 1, BREAK_SPACING_MARK},
+	{0x00ACB, 0x00ACC, 1, BREAK_SPACING_MARK},
+	{0x00ACD, 0x00ACD, 0, BREAK_EXTEND},
+	{0x00AE2, 0x00AE3, 0, BREAK_EXTEND},
+	{0x00AFA, 0x00AFF, 0, BREAK_EXTEND},
+	{0x00B01, 0x00B01, 0, BREAK_EXTEND},
+	{0x00B02, 0x00B03, 1, BREAK_SPACING_MARK},
+	{0x00B3C, 0x00B3C, 0, BREAK_EXTEND},
+	{0x00B3E, 0x00B3E, 1, BREAK_SPACING_MARK},
+	{0x00B3F, 0x00B3F, 0, BREAK_EXTEND},
+	{0x00B40, 0x00B40, 1, BREAK_SPACING_MARK},
+	{0x00B41, 0x00B44, 0, BREAK_EXTEND},
+	{0x00B47, 0x00B48, 1, BREAK_SPACING_MARK},
+	{0x00B4B, 0x00B4C, 1, BREAK_SPACING_MARK},
+	{0x00B4D, 0x00B4D, 0, BREAK_EXTEND},
+	{0x00B55, 0x00B56, 0, BREAK_EXTEND},
+	{0x00B57, 0x00B57, 1, BREAK_SPACING_MARK},
+	{0x00B62, 0x00B63, 0, BREAK_EXTEND},
+	{0x00B82, 0x00B82, 0, BREAK_EXTEND},
+	{0x00BBE, 0x00BBF, 1, BREAK_SPACING_MARK},
+	{0x00BC0, 0x00BC0, 0, BREAK_EXTEND},
+	{0x00BC1, 0x00BC2, 1, BREAK_SPACING_MARK},
+	{0x00BC6, 0x00BC8, 1, BREAK_SPACING_MARK},
+	{0x00BCA, 0x00BCC, 1, BREAK_SPACING_MARK},
+	{0x00BCD, 0x00BCD, 0, BREAK_EXTEND},
+	{0x00BD7, 0x00BD7, 1, BREAK_SPACING_MARK},
+	{0x00C00, 0x00C00, 0, BREAK_EXTEND},
+	{0x00C01, 0x00C03, 1, BREAK_SPACING_MARK},
+	{0x00C04, 0x00C04, 0, BREAK_EXTEND},
+	{0x00C3C, 0x00C3C, 0, BREAK_EXTEND},
+	{0x00C3E, 0x00C40, 0, BREAK_EXTEND},
+	{0x00C41, 0x00C44, 1, BREAK_SPACING_MARK},
+	{0x00C46, 0x00C48, 0, BREAK_EXTEND},
+	{0x00C4A, 0x00C4D, 0, BREAK_EXTEND},
+	{0x00C55, 0x00C56, 0, BREAK_EXTEND},
+	{0x00C62, 0x00C63, 0, BREAK_EXTEND},
+	{0x00C81, 0x00C81, 0, BREAK_EXTEND},
+	{0x00C82, 0x00C83, 1, BREAK_SPACING_MARK},
+	{0x00CBC, 0x00CBC, 0, BREAK_EXTEND},
+	{0x00CBE, 0x00CBE, 1, BREAK_SPACING_MARK},
+	{0x00CBF, 0x00CBF, 0, BREAK_EXTEND},
+	{0x00CC0, 0x00CC4, 1, BREAK_SPACING_MARK},
+	{0x00CC6, 0x00CC6, 0, BREAK_EXTEND},
+	{0x00CC7, 0x00CC8, 1, BREAK_SPACING_MARK},
+	{0x00CCA, 0x00CCB, 1, BREAK_SPACING_MARK},
+	{0x00CCC, 0x00CCD, 0, BREAK_EXTEND},
+	{0x00CD5, 0x00CD6, 1, BREAK_SPACING_MARK},
+	{0x00CE2, 0x00CE3, 0, BREAK_EXTEND},
+	{0x00D00, 0x00D01, 0, BREAK_EXTEND},
+	{0x00D02, 0x00D03, 1, BREAK_SPACING_MARK},
+	{0x00D3B, 0x00D3C, 0, BREAK_EXTEND},
+	{0x00D3E, 0x00D40, 1, BREAK_SPACING_MARK},
+	{0x00D41, 0x00D44, 0, BREAK_EXTEND},
+	{0x00D46, 0x00D48, 1, BREAK_SPACING_MARK},
+	{0x00D4A, 0x00D4C, 1, BREAK_SPACING_MARK},
+	{0x00D4D, 0x00D4D, 0, BREAK_EXTEND},
+	{0x00D57, 0x00D57, 1, BREAK_SPACING_MARK},
+	{0x00D62, 0x00D63, 0, BREAK_EXTEND},
+	{0x00D81, 0x00D81, 0, BREAK_EXTEND},
+	{0x00D82, 0x00D83, 1, BREAK_SPACING_MARK},
+	{0x00DCA, 0x00DCA, 0, BREAK_EXTEND},
+	{0x00DCF, 0x00DD1, 1, BREAK_SPACING_MARK},
+	{0x00DD2, 0x00DD4, 0, BREAK_EXTEND},
+	{0x00DD6, 0x00DD6, 0, BREAK_EXTEND},
+	{0x00DD8, 0x00DDF, 1, BREAK_SPACING_MARK},
+	{0x00DF2, 0x00DF3, 1, BREAK_SPACING_MARK},
+	{0x00E31, 0x00E31, 0, BREAK_EXTEND},
+	{0x00E34, 0x00E3A, 0, BREAK_EXTEND},
+	{0x00E47, 0x00E4E, 0, BREAK_EXTEND},
+	{0x00EB1, 0x00EB1, 0, BREAK_EXTEND},
+	{0x00EB4, 0x00EBC, 0, BREAK_EXTEND},
+	{0x00EC8, 0x00ECD, 0, BREAK_EXTEND},
+	{0x00F18, 0x00F19, 0, BREAK_EXTEND},
+	{0x00F35, 0x00F35, 0, BREAK_EXTEND},
+	{0x00F37, 0x00F37, 0, BREAK_EXTEND},
+	{0x00F39, 0x00F39, 0, BREAK_EXTEND},
+	{0x00F3E, 0x00F3F, 1, BREAK_SPACING_MARK},
+	{0x00F71, 0x00F7E, 0, BREAK_EXTEND},
+	{0x00F7F, 0x00F7F, 1, BREAK_SPACING_MARK},
+	{0x00F80, 0x00F84, 0, BREAK_EXTEND},
+	{0x00F86, 0x00F87, 0, BREAK_EXTEND},
+	{0x00F8D, 0x00F97, 0, BREAK_EXTEND},
+	{0x00F99, 0x00FBC, 0, BREAK_EXTEND},
+	{0x00FC6, 0x00FC6, 0, BREAK_EXTEND},
+	{0x0102B, 0x0102C, 1, BREAK_SPACING_MARK},
+	{0x0102D, 0x01030, 0, BREAK_EXTEND},
+	{0x01031, 0x01031, 1, BREAK_SPACING_MARK},
+	{0x01032, 0x01037, 0, BREAK_EXTEND},
+	{0x01038, 0x01038, 1, BREAK_SPACING_MARK},
+	{0x01039, 0x0103A, 0, BREAK_EXTEND},
+	{0x0103B, 0x0103C, 1, BREAK_SPACING_MARK},
+	{0x0103D, 0x0103E, 0, BREAK_EXTEND},
+	{0x01056, 0x01057, 1, BREAK_SPACING_MARK},
+	{0x01058, 0x01059, 0, BREAK_EXTEND},
+	{0x0105E, 0x01060, 0, BREAK_EXTEND},
+	{0x01062, 0x01064, 1, BREAK_SPACING_MARK},
+	{0x01067, 0x0106D, 1, BREAK_SPACING_MARK},
+	{0x01071, 0x01074, 0, BREAK_EXTEND},
+	{0x01082, 0x01082, 0, BREAK_EXTEND},
+	{0x01083, 0x01084, 1, BREAK_SPACING_MARK},
+	{0x01085, 0x01086, 0, BREAK_EXTEND},
+	{0x01087, 0x0108C, 1, BREAK_SPACING_MARK},
+	{0x0108D, 0x0108D, 0, BREAK_EXTEND},
+	{0x0108F, 0x0108F, 1, BREAK_SPACING_MARK},
+	{0x0109A, 0x0109C, 1, BREAK_SPACING_MARK},
+	{0x0109D, 0x0109D, 0, BREAK_EXTEND},
+	{0x01100, 0x0115F, 2, BREAK_OTHER},
+	{0x01160, 0x011FF, 0, BREAK_OTHER},
+	{0x0135D, 0x0135F, 0, BREAK_EXTEND},
+	{0x01712, 0x01714, 0, BREAK_EXTEND},
+	{0x01715, 0x01715, 1, BREAK_SPACING_MARK},
+	{0x01732, 0x01733, 0, BREAK_EXTEND},
+	{0x01734, 0x01734, 1, BREAK_SPACING_MARK},
+	{0x01752, 0x01753, 0, BREAK_EXTEND},
+	{0x01772, 0x01773, 0, BREAK_EXTEND},
+	{0x017B4, 0x017B5, 0, BREAK_EXTEND},
+	{0x017B6, 0x017B6, 1, BREAK_SPACING_MARK},
+	{0x017B7, 0x017BD, 0, BREAK_EXTEND},
+	{0x017BE, 0x017C5, 1, BREAK_SPACING_MARK},
+	{0x017C6, 0x017C6, 0, BREAK_EXTEND},
+	{0x017C7, 0x017C8, 1, BREAK_SPACING_MARK},
+	{0x017C9, 0x017D3, 0, BREAK_EXTEND},
+	{0x017DD, 0x017DD, 0, BREAK_EXTEND},
+	{0x0180B, 0x0180D, 0, BREAK_EXTEND},
+	{0x0180E, 0x0180E, 0, BREAK_CONTROL},
+	{0x0180F, 0x0180F, 0, BREAK_EXTEND},
+	{0x01885, 0x01886, 0, BREAK_EXTEND},
+	{0x018A9, 0x018A9, 0, BREAK_EXTEND},
+	{0x01920, 0x01922, 0, BREAK_EXTEND},
+	{0x01923, 0x01926, 1, BREAK_SPACING_MARK},
+	{0x01927, 0x01928, 0, BREAK_EXTEND},
+	{0x01929, 0x0192B, 1, BREAK_SPACING_MARK},
+	{0x01930, 0x01931, 1, BREAK_SPACING_MARK},
+	{0x01932, 0x01932, 0, BREAK_EXTEND},
+	{0x01933, 0x01938, 1, BREAK_SPACING_MARK},
+	{0x01939, 0x0193B, 0, BREAK_EXTEND},
+	{0x01A17, 0x01A18, 0, BREAK_EXTEND},
+	{0x01A19, 0x01A1A, 1, BREAK_SPACING_MARK},
+	{0x01A1B, 0x01A1B, 0, BREAK_EXTEND},
+	{0x01A55, 0x01A55, 1, BREAK_SPACING_MARK},
+	{0x01A56, 0x01A56, 0, BREAK_EXTEND},
+	{0x01A57, 0x01A57, 1, BREAK_SPACING_MARK},
+	{0x01A58, 0x01A5E, 0, BREAK_EXTEND},
+	{0x01A60, 0x01A60, 0, BREAK_EXTEND},
+	{0x01A61, 0x01A61, 1, BREAK_SPACING_MARK},
+	{0x01A62, 0x01A62, 0, BREAK_EXTEND},
+	{0x01A63, 0x01A64, 1, BREAK_SPACING_MARK},
+	{0x01A65, 0x01A6C, 0, BREAK_EXTEND},
+	{0x01A6D, 0x01A72, 1, BREAK_SPACING_MARK},
+	{0x01A73, 0x01A7C, 0, BREAK_EXTEND},
+	{0x01A7F, 0x01A7F, 0, BREAK_EXTEND},
+	{0x01AB0, 0x01ACE, 0, BREAK_EXTEND},
+	{0x01B00, 0x01B03, 0, BREAK_EXTEND},
+	{0x01B04, 0x01B04, 1, BREAK_SPACING_MARK},
+	{0x01B34, 0x01B34, 0, BREAK_EXTEND},
+	{0x01B35, 0x01B35, 1, BREAK_SPACING_MARK},
+	{0x01B36, 0x01B3A, 0, BREAK_EXTEND},
+	{0x01B3B, 0x01B3B, 1, BREAK_SPACING_MARK},
+	{0x01B3C, 0x01B3C, 0, BREAK_EXTEND},
+	{0x01B3D, 0x01B41, 1, BREAK_SPACING_MARK},
+	{0x01B42, 0x01B42, 0, BREAK_EXTEND},
+	{0x01B43, 0x01B44, 1, BREAK_SPACING_MARK},
+	{0x01B6B, 0x01B73, 0, BREAK_EXTEND},
+	{0x01B80, 0x01B81, 0, BREAK_EXTEND},
+	{0x01B82, 0x01B82, 1, BREAK_SPACING_MARK},
+	{0x01BA1, 0x01BA1, 1, BREAK_SPACING_MARK},
+	{0x01BA2, 0x01BA5, 0, BREAK_EXTEND},
+	{0x01BA6, 0x01BA7, 1, BREAK_SPACING_MARK},
+	{0x01BA8, 0x01BA9, 0, BREAK_EXTEND},
+	{0x01BAA, 0x01BAA, 1, BREAK_SPACING_MARK},
+	{0x01BAB, 0x01BAD, 0, BREAK_EXTEND},
+	{0x01BE6, 0x01BE6, 0, BREAK_EXTEND},
+	{0x01BE7, 0x01BE7, 1, BREAK_SPACING_MARK},
+	{0x01BE8, 0x01BE9, 0, BREAK_EXTEND},
+	{0x01BEA, 0x01BEC, 1, BREAK_SPACING_MARK},
+	{0x01BED, 0x01BED, 0, BREAK_EXTEND},
+	{0x01BEE, 0x01BEE, 1, BREAK_SPACING_MARK},
+	{0x01BEF, 0x01BF1, 0, BREAK_EXTEND},
+	{0x01BF2, 0x01BF3, 1, BREAK_SPACING_MARK},
+	{0x01C24, 0x01C2B, 1, BREAK_SPACING_MARK},
+	{0x01C2C, 0x01C33, 0, BREAK_EXTEND},
+	{0x01C34, 0x01C35, 1, BREAK_SPACING_MARK},
+	{0x01C36, 0x01C37, 0, BREAK_EXTEND},
+	{0x01CD0, 0x01CD2, 0, BREAK_EXTEND},
+	{0x01CD4, 0x01CE0, 0, BREAK_EXTEND},
+	{0x01CE1, 0x01CE1, 1, BREAK_SPACING_MARK},
+	{0x01CE2, 0x01CE8, 0, BREAK_EXTEND},
+	{0x01CED, 0x01CED, 0, BREAK_EXTEND},
+	{0x01CF4, 0x01CF4, 0, BREAK_EXTEND},
+	{0x01CF7, 0x01CF7, 1, BREAK_SPACING_MARK},
+	{0x01CF8, 0x01CF9, 0, BREAK_EXTEND},
+	{0x01DC0, 0x01DFF, 0, BREAK_EXTEND},
+	{0x0200B, 0x0200B, 0, BREAK_CONTROL},
+	{0x0200C, 0x0200C, 0, BREAK_EXTEND},
+	{0x0200D, 0x0200D, 0, BREAK_ZWJ},
+	{0x0200E, 0x0200F, 0, BREAK_CONTROL},
+	{0x02028, 0x02029, 1, BREAK_CONTROL},
+	{0x0202A, 0x0202E, 0, BREAK_CONTROL},
+	{0x0203C, 0x0203C, 1, BREAK_PICTOGRAPHIC},
+	{0x02049, 0x02049, 1, BREAK_PICTOGRAPHIC},
+	{0x02060, 0x02064, 0, BREAK_CONTROL},
+	{0x02066, 0x0206F, 0, BREAK_CONTROL},
+	{0x020D0, 0x020F0, 0, BREAK_EXTEND},
+	{0x02122, 0x02122, 1, BREAK_PICTOGRAPHIC},
+	{0x02139, 0x02139, 1, BREAK_PICTOGRAPHIC},
+	{0x02194, 0x02199, 1, BREAK_PICTOGRAPHIC},
+	{0x021A9, 0x021AA, 1, BREAK_PICTOGRAPHIC},
+	{0x0231A, 0x0231B, 2, BREAK_PICTOGRAPHIC},
+	{0x02328, 0x02328, 1, BREAK_PICTOGRAPHIC},
+	{0x02329, 0x0232A, 2, BREAK_OTHER},
+	{0x023CF, 0x023CF, 1, BREAK_PICTOGRAPHIC},
+	{0x023E9, 0x023EC, 2, BREAK_PICTOGRAPHIC},
+	{0x023ED, 0x023EF, 1, BREAK_PICTOGRAPHIC},
+	{0x023F0, 0x023F0, 2, BREAK_PICTOGRAPHIC},
+	{0x023F1, 0x023F2, 1, BREAK_PICTOGRAPHIC},
+	{0x023F3, 0x023F3, 2, BREAK_PICTOGRAPHIC},
+	{0x023F8, 0x023FA, 1, BREAK_PICTOGRAPHIC},
+	{0x024C2, 0x024C2, 1, BREAK_PICTOGRAPHIC},
+	{0x025AA, 0x025AB, 1, BREAK_PICTOGRAPHIC},
+	{0x025B6, 0x025B6, 1, BREAK_PICTOGRAPHIC},
+	{0x025C0, 0x025C0, 1, BREAK_PICTOGRAPHIC},
+	{0x025FB, 0x025FC, 1, BREAK_PICTOGRAPHIC},
+	{0x025FD, 0x025FE, 2, BREAK_PICTOGRAPHIC},
+	{0x02600, 0x02613, 1, BREAK_PICTOGRAPHIC},
+	{0x02614, 0x02615, 2, BREAK_PICTOGRAPHIC},
+	{0x02616, 0x02647, 1, BREAK_PICTOGRAPHIC},
+	{0x02648, 0x02653, 2, BREAK_PICTOGRAPHIC},
+	{0x02654, 0x0267E, 1, BREAK_PICTOGRAPHIC},
+	{0x0267F, 0x0267F, 2, BREAK_PICTOGRAPHIC},
+	{0x02680, 0x02692, 1, BREAK_PICTOGRAPHIC},
+	{0x02693, 0x02693, 2, BREAK_PICTOGRAPHIC},
+	{0x02694, 0x026A0, 1, BREAK_PICTOGRAPHIC},
+	{0x026A1, 0x026A1, 2, BREAK_PICTOGRAPHIC},
+	{0x026A2, 0x026A9, 1, BREAK_PICTOGRAPHIC},
+	{0x026AA, 0x026AB, 2, BREAK_PICTOGRAPHIC},
+	{0x026AC, 0x026BC, 1, BREAK_PICTOGRAPHIC},
+	{0x026BD, 0x026BE, 2, BREAK_PICTOGRAPHIC},
+	{0x026BF, 0x026C3, 1, BREAK_PICTOGRAPHIC},
+	{0x026C4, 0x026C5, 2, BREAK_PICTOGRAPHIC},
+	{0x026C6, 0x026CD, 1, BREAK_PICTOGRAPHIC},
+	{0x026CE, 0x026CE, 2, BREAK_PICTOGRAPHIC},
+	{0x026CF, 0x026D3, 1, BREAK_PICTOGRAPHIC},
+	{0x026D4, 0x026D4, 2, BREAK_PICTOGRAPHIC},
+	{0x026D5, 0x026E9, 1, BREAK_PICTOGRAPHIC},
+	{0x026EA, 0x026EA, 2, BREAK_PICTOGRAPHIC},
+	{0x026EB, 0x026F1, 1, BREAK_PICTOGRAPHIC},
+	{0x026F2, 0x026F3, 2, BREAK_PICTOGRAPHIC},
+	{0x026F4, 0x026F4, 1, BREAK_PICTOGRAPHIC},
+	{0x026F5, 0x026F5, 2, BREAK_PICTOGRAPHIC},
+	{0x026F6, 0x026F9, 1, BREAK_PICTOGRAPHIC},
+	{0x026FA, 0x026FA, 2, BREAK_PICTOGRAPHIC},
+	{0x026FB, 0x026FC, 1, BREAK_PICTOGRAPHIC},
+	{0x026FD, 0x026FD, 2, BREAK_PICTOGRAPHIC},
+	{0x026FE, 0x02704, 1, BREAK_PICTOGRAPHIC},
+	{0x02705, 0x02705, 2, BREAK_PICTOGRAPHIC},
+	{0x02706, 0x02709, 1, BREAK_PICTOGRAPHIC},
+	{0x0270A, 0x0270B, 2, BREAK_PICTOGRAPHIC},
+	{0x0270C, 0x02727, 1, BREAK_PICTOGRAPHIC},
+	{0x02728, 0x02728, 2, BREAK_PICTOGRAPHIC},
+	{0x02729, 0x0274B, 1, BREAK_PICTOGRAPHIC},
+	{0x0274C, 0x0274C, 2, BREAK_PICTOGRAPHIC},
+	{0x0274D, 0x0274D, 1, BREAK_PICTOGRAPHIC},
+	{0x0274E, 0x0274E, 2, BREAK_PICTOGRAPHIC},
+	{0x0274F, 0x02752, 1, BREAK_PICTOGRAPHIC},
+	{0x02753, 0x02755, 2, BREAK_PICTOGRAPHIC},
+	{0x02756, 0x02756, 1, BREAK_PICTOGRAPHIC},
+	{0x02757, 0x02757, 2, BREAK_PICTOGRAPHIC},
+	{0x02758, 0x02794, 1, BREAK_PICTOGRAPHIC},
+	{0x02795, 0x02797, 2, BREAK_PICTOGRAPHIC},
+	{0x02798, 0x027AF, 1, BREAK_PICTOGRAPHIC},
+	{0x027B0, 0x027B0, 2, BREAK_PICTOGRAPHIC},
+	{0x027B1, 0x027BE, 1, BREAK_PICTOGRAPHIC},
+	{0x027BF, 0x027BF, 2, BREAK_PICTOGRAPHIC},
+	{0x02934, 0x02935, 1, BREAK_PICTOGRAPHIC},
+	{0x02B05, 0x02B07, 1, BREAK_PICTOGRAPHIC},
+	{0x02B1B, 0x02B1C, 2, BREAK_PICTOGRAPHIC},
+	{0x02B50, 0x02B50, 2, BREAK_PICTOGRAPHIC},
+	{0x02B55, 0x02B55, 2, BREAK_PICTOGRAPHIC},
+	{0x02CEF, 0x02CF1, 0, BREAK_EXTEND},
+	{0x02D7F, 0x02D7F, 0, BREAK_EXTEND},
+	{0x02DE0, 0x02DFF, 0, BREAK_EXTEND},
+	{0x02E80, 0x02E99, 2, BREAK_OTHER},
+	{0x02E9B, 0x02EF3, 2, BREAK_OTHER},
+	{0x02F00, 0x02FD5, 2, BREAK_OTHER},
+	{0x02FF0, 0x02FFB, 2, BREAK_OTHER},
+	{0x03000, 0x03029, 2, BREAK_OTHER},
+	{0x0302A, 0x0302D, 0, BREAK_EXTEND},
+	{0x0302E, 0x0302F, 2, BREAK_SPACING_MARK},
+	{0x03030, 0x03030, 2, BREAK_PICTOGRAPHIC},
+	{0x03031, 0x0303C, 2, BREAK_OTHER},
+	{0x0303D, 0x0303D, 2, BREAK_PICTOGRAPHIC},
+	{0x0303E, 0x0303E, 2, BREAK_OTHER},
+	{0x03041, 0x03096, 2, BREAK_OTHER},
+	{0x03099, 0x0309A, 0, BREAK_EXTEND},
+	{0x0309B, 0x030FF, 2, BREAK_OTHER},
+	{0x03105, 0x0312F, 2, BREAK_OTHER},
+	{0x03131, 0x0318E, 2, BREAK_OTHER},
+	{0x03190, 0x031E3, 2, BREAK_OTHER},
+	{0x031F0, 0x0321E, 2, BREAK_OTHER},
+	{0x03220, 0x03247, 2, BREAK_OTHER},
+	{0x03250, 0x03296, 2, BREAK_OTHER},
+	{0x03297, 0x03297, 2, BREAK_PICTOGRAPHIC},
+	{0x03298, 0x03298, 2, BREAK_OTHER},
+	{0x03299, 0x03299, 2, BREAK_PICTOGRAPHIC},
+	{0x0329A, 0x04DBF, 2, BREAK_OTHER},
+	{0x04E00, 0x0A48C, 2, BREAK_OTHER},
+	{0x0A490, 0x0A4C6, 2, BREAK_OTHER},
+	{0x0A66F, 0x0A672, 0, BREAK_EXTEND},
+	{0x0A674, 0x0A67D, 0, BREAK_EXTEND},
+	{0x0A69E, 0x0A69F, 0, BREAK_EXTEND},
+	{0x0A6F0, 0x0A6F1, 0, BREAK_EXTEND},
+	{0x0A802, 0x0A802, 0, BREAK_EXTEND},
+	{0x0A806, 0x0A806, 0, BREAK_EXTEND},
+	{0x0A80B, 0x0A80B, 0, BREAK_EXTEND},
+	{0x0A823, 0x0A824, 1, BREAK_SPACING_MARK},
+	{0x0A825, 0x0A826, 0, BREAK_EXTEND},
+	{0x0A827, 0x0A827, 1, BREAK_SPACING_MARK},
+	{0x0A82C, 0x0A82C, 0, BREAK_EXTEND},
+	{0x0A880, 0x0A881, 1, BREAK_SPACING_MARK},
+	{0x0A8B4, 0x0A8C3, 1, BREAK_SPACING_MARK},
+	{0x0A8C4, 0x0A8C5, 0, BREAK_EXTEND},
+	{0x0A8E0, 0x0A8F1, 0, BREAK_EXTEND},
+	{0x0A8FF, 0x0A8FF, 0, BREAK_EXTEND},
+	{0x0A926, 0x0A92D, 0, BREAK_EXTEND},
+	{0x0A947, 0x0A951, 0, BREAK_EXTEND},
+	{0x0A952, 0x0A953, 1, BREAK_SPACING_MARK},
+	{0x0A960, 0x0A97C, 2, BREAK_OTHER},
+	{0x0A980, 0x0A982, 0, BREAK_EXTEND},
+	{0x0A983, 0x0A983, 1, BREAK_SPACING_MARK},
+	{0x0A9B3, 0x0A9B3, 0, BREAK_EXTEND},
+	{0x0A9B4, 0x0A9B5, 1, BREAK_SPACING_MARK},
+	{0x0A9B6, 0x0A9B9, 0, BREAK_EXTEND},
+	{0x0A9BA, 0x0A9BB, 1, BREAK_SPACING_MARK},
+	{0x0A9BC, 0x0A9BD, 0, BREAK_EXTEND},
+	{0x0A9BE, 0x0A9C0, 1, BREAK_SPACING_MARK},
+	{0x0A9E5, 0x0A9E5, 0, BREAK_EXTEND},
+	{0x0AA29, 0x0AA2E, 0, BREAK_EXTEND},
+	{0x0AA2F, 0x0AA30, 1, BREAK_SPACING_MARK},
+	{0x0AA31, 0x0AA32, 0, BREAK_EXTEND},
+	{0x0AA33, 0x0AA34, 1, BREAK_SPACING_MARK},
+	{0x0AA35, 0x0AA36, 0, BREAK_EXTEND},
+	{0x0AA43, 0x0AA43, 0, BREAK_EXTEND},
+	{0x0AA4C, 0x0AA4C, 0, BREAK_EXTEND},
+	{0x0AA4D, 0x0AA4D, 1, BREAK_SPACING_MARK},
+	{0x0AA7B, 0x0AA7B, 1, BREAK_SPACING_MARK},
+	{0x0AA7C, 0x0AA7C, 0, BREAK_EXTEND},
+	{0x0AA7D, 0x0AA7D, 1, BREAK_SPACING_MARK},
+	{0x0AAB0, 0x0AAB0, 0, BREAK_EXTEND},
+	{0x0AAB2, 0x0AAB4, 0, BREAK_EXTEND},
+	{0x0AAB7, 0x0AAB8, 0, BREAK_EXTEND},
+	{0x0AABE, 0x0AABF, 0, BREAK_EXTEND},
+	{0x0AAC1, 0x0AAC1, 0, BREAK_EXTEND},
+	{0x0AAEB, 0x0AAEB, 1, BREAK_SPACING_MARK},
+	{0x0AAEC, 0x0AAED, 0, BREAK_EXTEND},
+	{0x0AAEE, 0x0AAEF, 1, BREAK_SPACING_MARK},
+	{0x0AAF5, 0x0AAF5, 1, BREAK_SPACING_MARK},
+	{0x0AAF6, 0x0AAF6, 0, BREAK_EXTEND},
+	{0x0ABE3, 0x0ABE4, 1, BREAK_SPACING_MARK},
+	{0x0ABE5, 0x0ABE5, 0, BREAK_EXTEND},
+	{0x0ABE6, 0x0ABE7, 1, BREAK_SPACING_MARK},
+	{0x0ABE8, 0x0ABE8, 0, BREAK_EXTEND},
+	{0x0ABE9, 0x0ABEA, 1, BREAK_SPACING_MARK},
+	{0x0ABEC, 0x0ABEC, 1, BREAK_SPACING_MARK},
+	{0x0ABED, 0x0ABED, 0, BREAK_EXTEND},
+	{0x0AC00, 0x0D7A3, 2, BREAK_OTHER},
+	{0x0F900, 0x0FA6D, 2, BREAK_OTHER},
+	{0x0FA70, 0x0FAD9, 2, BREAK_OTHER},
+	{0x0FB1E, 0x0FB1E, 0, BREAK_EXTEND},
+	{0x0FE00, 0x0FE0F, 0, BREAK_EXTEND},
+	{0x0FE10, 0x0FE19, 2, BREAK_OTHER},
+	{0x0FE20, 0x0FE2F, 0, BREAK_EXTEND},
+	{0x0FE30, 0x0FE52, 2, BREAK_OTHER},
+	{0x0FE54, 0x0FE66, 2, BREAK_OTHER},
+	{0x0FE68, 0x0FE6B, 2, BREAK_OTHER},
+	{0x0FEFF, 0x0FEFF, 0, BREAK_CONTROL},
+	{0x0FF01, 0x0FF60, 2, BREAK_OTHER},
+	{0x0FF9E, 0x0FF9F, 1, BREAK_EXTEND},
+	{0x0FFE0, 0x0FFE6, 2, BREAK_OTHER},
+	{0x0FFF9, 0x0FFFB, 0, BREAK_CONTROL},
+	{0x101FD, 0x101FD, 0, BREAK_EXTEND},
+	{0x102E0, 0x102E0, 0, BREAK_EXTEND},
+	{0x10376, 0x1037A, 0, BREAK_EXTEND},
+	{0x10A01, 0x10A03, 0, BREAK_EXTEND},
+	{0x10A05, 0x10A06, 0, BREAK_EXTEND},
+	{0x10A0C, 0x10A0F, 0, BREAK_EXTEND},
+	{0x10A38, 0x10A3A, 0, BREAK_EXTEND},
+	{0x10A3F, 0x10A3F, 0, BREAK_EXTEND},
+	{0x10AE5, 0x10AE6, 0, BREAK_EXTEND},
+	{0x10D24, 0x10D27, 0, BREAK_EXTEND},
+	{0x10EAB, 0x10EAC, 0, BREAK_EXTEND},
+	{0x10F46, 0x10F50, 0, BREAK_EXTEND},
+	{0x10F82, 0x10F85, 0, BREAK_EXTEND},
+	{0x11000, 0x11000, 1, BREAK_SPACING_MARK},
+	{0x11001, 0x11001, 0, BREAK_EXTEND},
+	{0x11002, 0x11002, 1, BREAK_SPACING_MARK},
+	{0x11038, 0x11046, 0, BREAK_EXTEND},
+	{0x11070, 0x11070, 0, BREAK_EXTEND},
+	{0x11073, 0x11074, 0, BREAK_EXTEND},
+	{0x1107F, 0x11081, 0, BREAK_EXTEND},
+	{0x11082, 0x11082, 1, BREAK_SPACING_MARK},
+	{0x110B0, 0x110B2, 1, BREAK_SPACING_MARK},
+	{0x110B3, 0x110B6, 0, BREAK_EXTEND},
+	{0x110B7, 0x110B8, 1, BREAK_SPACING_MARK},
+	{0x110B9, 0x110BA, 0, BREAK_EXTEND},
+	{0x110BD, 0x110BD, 0, BREAK_CONTROL},
+	{0x110C2, 0x110C2, 0, BREAK_EXTEND},
+	{0x110CD, 0x110CD, 0, BREAK_CONTROL},
+	{0x11100, 0x11102, 0, BREAK_EXTEND},
+	{0x11127, 0x1112B, 0, BREAK_EXTEND},
+	{0x1112C, 0x1112C, 1, BREAK_SPACING_MARK},
+	{0x1112D, 0x11134, 0, BREAK_EXTEND},
+	{0x11145, 0x11146, 1, BREAK_SPACING_MARK},
+	{0x11173, 0x11173, 0, BREAK_EXTEND},
+	{0x11180, 0x11181, 0, BREAK_EXTEND},
+	{0x11182, 0x11182, 1, BREAK_SPACING_MARK},
+	{0x111B3, 0x111B5, 1, BREAK_SPACING_MARK},
+	{0x111B6, 0x111BE, 0, BREAK_EXTEND},
+	{0x111BF, 0x111C0, 1, BREAK_SPACING_MARK},
+	{0x111C9, 0x111CC, 0, BREAK_EXTEND},
+	{0x111CE, 0x111CE, 1, BREAK_SPACING_MARK},
+	{0x111CF, 0x111CF, 0, BREAK_EXTEND},
+	{0x1122C, 0x1122E, 1, BREAK_SPACING_MARK},
+	{0x1122F, 0x11231, 0, BREAK_EXTEND},
+	{0x11232, 0x11233, 1, BREAK_SPACING_MARK},
+	{0x11234, 0x11234, 0, BREAK_EXTEND},
+	{0x11235, 0x11235, 1, BREAK_SPACING_MARK},
+	{0x11236, 0x11237, 0, BREAK_EXTEND},
+	{0x1123E, 0x1123E, 0, BREAK_EXTEND},
+	{0x112DF, 0x112DF, 0, BREAK_EXTEND},
+	{0x112E0, 0x112E2, 1, BREAK_SPACING_MARK},
+	{0x112E3, 0x112EA, 0, BREAK_EXTEND},
+	{0x11300, 0x11301, 0, BREAK_EXTEND},
+	{0x11302, 0x11303, 1, BREAK_SPACING_MARK},
+	{0x1133B, 0x1133C, 0, BREAK_EXTEND},
+	{0x1133E, 0x1133F, 1, BREAK_SPACING_MARK},
+	{0x11340, 0x11340, 0, BREAK_EXTEND},
+	{0x11341, 0x11344, 1, BREAK_SPACING_MARK},
+	{0x11347, 0x11348, 1, BREAK_SPACING_MARK},
+	{0x1134B, 0x1134D, 1, BREAK_SPACING_MARK},
+	{0x11357, 0x11357, 1, BREAK_SPACING_MARK},
+	{0x11362, 0x11363, 1, BREAK_SPACING_MARK},
+	{0x11366, 0x1136C, 0, BREAK_EXTEND},
+	{0x11370, 0x11374, 0, BREAK_EXTEND},
+	{0x11435, 0x11437, 1, BREAK_SPACING_MARK},
+	{0x11438, 0x1143F, 0, BREAK_EXTEND},
+	{0x11440, 0x11441, 1, BREAK_SPACING_MARK},
+	{0x11442, 0x11444, 0, BREAK_EXTEND},
+	{0x11445, 0x11445, 1, BREAK_SPACING_MARK},
+	{0x11446, 0x11446, 0, BREAK_EXTEND},
+	{0x1145E, 0x1145E, 0, BREAK_EXTEND},
+	{0x114B0, 0x114B2, 1, BREAK_SPACING_MARK},
+	{0x114B3, 0x114B8, 0, BREAK_EXTEND},
+	{0x114B9, 0x114B9, 1, BREAK_SPACING_MARK},
+	{0x114BA, 0x114BA, 0, BREAK_EXTEND},
+	{0x114BB, 0x114BE, 1, BREAK_SPACING_MARK},
+	{0x114BF, 0x114C0, 0, BREAK_EXTEND},
+	{0x114C1, 0x114C1, 1, BREAK_SPACING_MARK},
+	{0x114C2, 0x114C3, 0, BREAK_EXTEND},
+	{0x115AF, 0x115B1, 1, BREAK_SPACING_MARK},
+	{0x115B2, 0x115B5, 0, BREAK_EXTEND},
+	{0x115B8, 0x115BB, 1, BREAK_SPACING_MARK},
+	{0x115BC, 0x115BD, 0, BREAK_EXTEND},
+	{0x115BE, 0x115BE, 1, BREAK_SPACING_MARK},
+	{0x115BF, 0x115C0, 0, BREAK_EXTEND},
+	{0x115DC, 0x115DD, 0, BREAK_EXTEND},
+	{0x11630, 0x11632, 1, BREAK_SPACING_MARK},
+	{0x11633, 0x1163A, 0, BREAK_EXTEND},
+	{0x1163B, 0x1163C, 1, BREAK_SPACING_MARK},
+	{0x1163D, 0x1163D, 0, BREAK_EXTEND},
+	{0x1163E, 0x1163E, 1, BREAK_SPACING_MARK},
+	{0x1163F, 0x11640, 0, BREAK_EXTEND},
+	{0x116AB, 0x116AB, 0, BREAK_EXTEND},
+	{0x116AC, 0x116AC, 1, BREAK_SPACING_MARK},
+	{0x116AD, 0x116AD, 0, BREAK_EXTEND},
+	{0x116AE, 0x116AF, 1, BREAK_SPACING_MARK},
+	{0x116B0, 0x116B5, 0, BREAK_EXTEND},
+	{0x116B6, 0x116B6, 1, BREAK_SPACING_MARK},
+	{0x116B7, 0x116B7, 0, BREAK_EXTEND},
+	{0x1171D, 0x1171F, 0, BREAK_EXTEND},
+	{0x11720, 0x11721, 1, BREAK_SPACING_MARK},
+	{0x11722, 0x11725, 0, BREAK_EXTEND},
+	{0x11726, 0x11726, 1, BREAK_SPACING_MARK},
+	{0x11727, 0x1172B, 0, BREAK_EXTEND},
+	{0x1182C, 0x1182E, 1, BREAK_SPACING_MARK},
+	{0x1182F, 0x11837, 0, BREAK_EXTEND},
+	{0x11838, 0x11838, 1, BREAK_SPACING_MARK},
+	{0x11839, 0x1183A, 0, BREAK_EXTEND},
+	{0x11930, 0x11935, 1, BREAK_SPACING_MARK},
+	{0x11937, 0x11938, 1, BREAK_SPACING_MARK},
+	{0x1193B, 0x1193C, 0, BREAK_EXTEND},
+	{0x1193D, 0x1193D, 1, BREAK_SPACING_MARK},
+	{0x1193E, 0x1193E, 0, BREAK_EXTEND},
+	{0x11940, 0x11940, 1, BREAK_SPACING_MARK},
+	{0x11942, 0x11942, 1, BREAK_SPACING_MARK},
+	{0x11943, 0x11943, 0, BREAK_EXTEND},
+	{0x119D1, 0x119D3, 1, BREAK_SPACING_MARK},
+	{0x119D4, 0x119D7, 0, BREAK_EXTEND},
+	{0x119DA, 0x119DB, 0, BREAK_EXTEND},
+	{0x119DC, 0x119DF, 1, BREAK_SPACING_MARK},
+	{0x119E0, 0x119E0, 0, BREAK_EXTEND},
+	{0x119E4, 0x119E4, 1, BREAK_SPACING_MARK},
+	{0x11A01, 0x11A0A, 0, BREAK_EXTEND},
+	{0x11A33, 0x11A38, 0, BREAK_EXTEND},
+	{0x11A39, 0x11A39, 1, BREAK_SPACING_MARK},
+	{0x11A3B, 0x11A3E, 0, BREAK_EXTEND},
+	{0x11A47, 0x11A47, 0, BREAK_EXTEND},
+	{0x11A51, 0x11A56, 0, BREAK_EXTEND},
+	{0x11A57, 0x11A58, 1, BREAK_SPACING_MARK},
+	{0x11A59, 0x11A5B, 0, BREAK_EXTEND},
+	{0x11A8A, 0x11A96, 0, BREAK_EXTEND},
+	{0x11A97, 0x11A97, 1, BREAK_SPACING_MARK},
+	{0x11A98, 0x11A99, 0, BREAK_EXTEND},
+	{0x11C2F, 0x11C2F, 1, BREAK_SPACING_MARK},
+	{0x11C30, 0x11C36, 0, BREAK_EXTEND},
+	{0x11C38, 0x11C3D, 0, BREAK_EXTEND},
+	{0x11C3E, 0x11C3E, 1, BREAK_SPACING_MARK},
+	{0x11C3F, 0x11C3F, 0, BREAK_EXTEND},
+	{0x11C92, 0x11CA7, 0, BREAK_EXTEND},
+	{0x11CA9, 0x11CA9, 1, BREAK_SPACING_MARK},
+	{0x11CAA, 0x11CB0, 0, BREAK_EXTEND},
+	{0x11CB1, 0x11CB1, 1, BREAK_SPACING_MARK},
+	{0x11CB2, 0x11CB3, 0, BREAK_EXTEND},
+	{0x11CB4, 0x11CB4, 1, BREAK_SPACING_MARK},
+	{0x11CB5, 0x11CB6, 0, BREAK_EXTEND},
+	{0x11D31, 0x11D36, 0, BREAK_EXTEND},
+	{0x11D3A, 0x11D3A, 0, BREAK_EXTEND},
+	{0x11D3C, 0x11D3D, 0, BREAK_EXTEND},
+	{0x11D3F, 0x11D45, 0, BREAK_EXTEND},
+	{0x11D47, 0x11D47, 0, BREAK_EXTEND},
+	{0x11D8A, 0x11D8E, 1, BREAK_SPACING_MARK},
+	{0x11D90, 0x11D91, 0, BREAK_EXTEND},
+	{0x11D93, 0x11D94, 1, BREAK_SPACING_MARK},
+	{0x11D95, 0x11D95, 0, BREAK_EXTEND},
+	{0x11D96, 0x11D96, 1, BREAK_SPACING_MARK},
+	{0x11D97, 0x11D97, 0, BREAK_EXTEND},
+	{0x11EF3, 0x11EF4, 0, BREAK_EXTEND},
+	{0x11EF5, 0x11EF6, 1, BREAK_SPACING_MARK},
+	{0x13430, 0x13438, 0, BREAK_CONTROL},
+	{0x16AF0, 0x16AF4, 0, BREAK_EXTEND},
+	{0x16B30, 0x16B36, 0, BREAK_EXTEND},
+	{0x16F4F, 0x16F4F, 0, BREAK_EXTEND},
+	{0x16F51, 0x16F87, 1, BREAK_SPACING_MARK},
+	{0x16F8F, 0x16F92, 0, BREAK_EXTEND},
+	{0x16FE0, 0x16FE3, 2, BREAK_OTHER},
+	{0x16FE4, 0x16FE4, 0, BREAK_EXTEND},
+	{0x16FF0, 0x16FF1, 2, BREAK_SPACING_MARK},
+	{0x17000, 0x187F7, 2, BREAK_OTHER},
+	{0x18800, 0x18CD5, 2, BREAK_OTHER},
+	{0x18D00, 0x18D08, 2, BREAK_OTHER},
+	{0x1AFF0, 0x1AFF3, 2, BREAK_OTHER},
+	{0x1AFF5, 0x1AFFB, 2, BREAK_OTHER},
+	{0x1AFFD, 0x1AFFE, 2, BREAK_OTHER},
+	{0x1B000, 0x1B122, 2, BREAK_OTHER},
+	{0x1B150, 0x1B152, 2, BREAK_OTHER},
+	{0x1B164, 0x1B167, 2, BREAK_OTHER},
+	{0x1B170, 0x1B2FB, 2, BREAK_OTHER},
+	{0x1BC9D, 0x1BC9E, 0, BREAK_EXTEND},
+	{0x1BCA0, 0x1BCA3, 0, BREAK_CONTROL},
+	{0x1CF00, 0x1CF2D, 0, BREAK_EXTEND},
+	{0x1CF30, 0x1CF46, 0, BREAK_EXTEND},
+	{0x1D165, 0x1D166, 1, BREAK_SPACING_MARK},
+	{0x1D167, 0x1D169, 0, BREAK_EXTEND},
+	{0x1D16D, 0x1D172, 1, BREAK_SPACING_MARK},
+	{0x1D173, 0x1D17A, 0, BREAK_CONTROL},
+	{0x1D17B, 0x1D182, 0, BREAK_EXTEND},
+	{0x1D185, 0x1D18B, 0, BREAK_EXTEND},
+	{0x1D1AA, 0x1D1AD, 0, BREAK_EXTEND},
+	{0x1D242, 0x1D244, 0, BREAK_EXTEND},
+	{0x1DA00, 0x1DA36, 0, BREAK_EXTEND},
+	{0x1DA3B, 0x1DA6C, 0, BREAK_EXTEND},
+	{0x1DA75, 0x1DA75, 0, BREAK_EXTEND},
+	{0x1DA84, 0x1DA84, 0, BREAK_EXTEND},
+	{0x1DA9B, 0x1DA9F, 0, BREAK_EXTEND},
+	{0x1DAA1, 0x1DAAF, 0, BREAK_EXTEND},
+	{0x1E000, 0x1E006, 0, BREAK_EXTEND},
+	{0x1E008, 0x1E018, 0, BREAK_EXTEND},
+	{0x1E01B, 0x1E021, 0, BREAK_EXTEND},
+	{0x1E023, 0x1E024, 0, BREAK_EXTEND},
+	{0x1E026, 0x1E02A, 0, BREAK_EXTEND},
+	{0x1E130, 0x1E136, 0, BREAK_EXTEND},
+	{0x1E2AE, 0x1E2AE, 0, BREAK_EXTEND},
+	{0x1E2EC, 0x1E2EF, 0, BREAK_EXTEND},
+	{0x1E8D0, 0x1E8D6, 0, BREAK_EXTEND},
+	{0x1E944, 0x1E94A, 0, BREAK_EXTEND},
+	{0x1F000, 0x1F003, 1, BREAK_PICTOGRAPHIC},
+	{0x1F004, 0x1F004, 2, BREAK_PICTOGRAPHIC},
+	{0x1F005, 0x1F0CE, 1, BREAK_PICTOGRAPHIC},
+	{0x1F0CF, 0x1F0CF, 2, BREAK_PICTOGRAPHIC},
+	{0x1F0D0, 0x1F0FF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F10D, 0x1F10F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F12F, 0x1F12F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F16C, 0x1F171, 1, BREAK_PICTOGRAPHIC},
+	{0x1F17E, 0x1F17F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F18E, 0x1F18E, 2, BREAK_PICTOGRAPHIC},
+	{0x1F191, 0x1F19A, 2, BREAK_PICTOGRAPHIC},
+	{0x1F1AD, 0x1F1E5, 1, BREAK_PICTOGRAPHIC},
+	{0x1F1E6, 0x1F1FF, 2, BREAK_REGIONAL_INDICATOR},
+	{0x1F200, 0x1F200, 2, BREAK_OTHER},
+	{0x1F201, 0x1F202, 2, BREAK_PICTOGRAPHIC},
+	{0x1F203, 0x1F20F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F210, 0x1F219, 2, BREAK_OTHER},
+	{0x1F21A, 0x1F21A, 2, BREAK_PICTOGRAPHIC},
+	{0x1F21B, 0x1F22E, 2, BREAK_OTHER},
+	{0x1F22F, 0x1F22F, 2, BREAK_PICTOGRAPHIC},
+	{0x1F230, 0x1F231, 2, BREAK_OTHER},
+	{0x1F232, 0x1F23A, 2, BREAK_PICTOGRAPHIC},
+	{0x1F23B, 0x1F23B, 2, BREAK_OTHER},
+	{0x1F23C, 0x1F23F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F240, 0x1F248, 2, BREAK_OTHER},
+	{0x1F249, 0x1F24F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F250, 0x1F251, 2, BREAK_PICTOGRAPHIC},
+	{0x1F252, 0x1F25F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F260, 0x1F265, 2, BREAK_PICTOGRAPHIC},
+	{0x1F266, 0x1F2FF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F300, 0x1F320, 2, BREAK_PICTOGRAPHIC},
+	{0x1F321, 0x1F32C, 1, BREAK_PICTOGRAPHIC},
+	{0x1F32D, 0x1F335, 2, BREAK_PICTOGRAPHIC},
+	{0x1F336, 0x1F336, 1, BREAK_PICTOGRAPHIC},
+	{0x1F337, 0x1F37C, 2, BREAK_PICTOGRAPHIC},
+	{0x1F37D, 0x1F37D, 1, BREAK_PICTOGRAPHIC},
+	{0x1F37E, 0x1F393, 2, BREAK_PICTOGRAPHIC},
+	{0x1F394, 0x1F39F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F3A0, 0x1F3CA, 2, BREAK_PICTOGRAPHIC},
+	{0x1F3CB, 0x1F3CE, 1, BREAK_PICTOGRAPHIC},
+	{0x1F3CF, 0x1F3D3, 2, BREAK_PICTOGRAPHIC},
+	{0x1F3D4, 0x1F3DF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F3E0, 0x1F3F0, 2, BREAK_PICTOGRAPHIC},
+	{0x1F3F1, 0x1F3F3, 1, BREAK_PICTOGRAPHIC},
+	{0x1F3F4, 0x1F3F4, 2, BREAK_PICTOGRAPHIC},
+	{0x1F3F5, 0x1F3F7, 1, BREAK_PICTOGRAPHIC},
+	{0x1F3F8, 0x1F3FA, 2, BREAK_PICTOGRAPHIC},
+	{0x1F3FB, 0x1F3FF, 2, BREAK_EXTEND},
+	{0x1F400, 0x1F43E, 2, BREAK_PICTOGRAPHIC},
+	{0x1F43F, 0x1F43F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F440, 0x1F440, 2, BREAK_PICTOGRAPHIC},
+	{0x1F441, 0x1F441, 1, BREAK_PICTOGRAPHIC},
+	{0x1F442, 0x1F4FC, 2, BREAK_PICTOGRAPHIC},
+	{0x1F4FD, 0x1F4FE, 1, BREAK_PICTOGRAPHIC},
+	{0x1F4FF, 0x1F53D, 2, BREAK_PICTOGRAPHIC},
+	{0x1F546, 0x1F54A, 1, BREAK_PICTOGRAPHIC},
+	{0x1F54B, 0x1F54E, 2, BREAK_PICTOGRAPHIC},
+	{0x1F54F, 0x1F54F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F550, 0x1F567, 2, BREAK_PICTOGRAPHIC},
+	{0x1F568, 0x1F579, 1, BREAK_PICTOGRAPHIC},
+	{0x1F57A, 0x1F57A, 2, BREAK_PICTOGRAPHIC},
+	{0x1F57B, 0x1F594, 1, BREAK_PICTOGRAPHIC},
+	{0x1F595, 0x1F596, 2, BREAK_PICTOGRAPHIC},
+	{0x1F597, 0x1F5A3, 1, BREAK_PICTOGRAPHIC},
+	{0x1F5A4, 0x1F5A4, 2, BREAK_PICTOGRAPHIC},
+	{0x1F5A5, 0x1F5FA, 1, BREAK_PICTOGRAPHIC},
+	{0x1F5FB, 0x1F64F, 2, BREAK_PICTOGRAPHIC},
+	{0x1F680, 0x1F6C5, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6C6, 0x1F6CB, 1, BREAK_PICTOGRAPHIC},
+	{0x1F6CC, 0x1F6CC, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6CD, 0x1F6CF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F6D0, 0x1F6D2, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6D3, 0x1F6D4, 1, BREAK_PICTOGRAPHIC},
+	{0x1F6D5, 0x1F6D7, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6D8, 0x1F6DC, 1, BREAK_PICTOGRAPHIC},
+	{0x1F6DD, 0x1F6DF, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6E0, 0x1F6EA, 1, BREAK_PICTOGRAPHIC},
+	{0x1F6EB, 0x1F6EC, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6ED, 0x1F6F3, 1, BREAK_PICTOGRAPHIC},
+	{0x1F6F4, 0x1F6FC, 2, BREAK_PICTOGRAPHIC},
+	{0x1F6FD, 0x1F6FF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F774, 0x1F77F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F7D5, 0x1F7DF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F7E0, 0x1F7EB, 2, BREAK_PICTOGRAPHIC},
+	{0x1F7EC, 0x1F7EF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F7F0, 0x1F7F0, 2, BREAK_PICTOGRAPHIC},
+	{0x1F7F1, 0x1F7FF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F80C, 0x1F80F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F848, 0x1F84F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F85A, 0x1F85F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F888, 0x1F88F, 1, BREAK_PICTOGRAPHIC},
+	{0x1F8AE, 0x1F8FF, 1, BREAK_PICTOGRAPHIC},
+	{0x1F90C, 0x1F93A, 2, BREAK_PICTOGRAPHIC},
+	{0x1F93C, 0x1F945, 2, BREAK_PICTOGRAPHIC},
+	{0x1F947, 0x1F9FF, 2, BREAK_PICTOGRAPHIC},
+	{0x1FA00, 0x1FA6F, 1, BREAK_PICTOGRAPHIC},
+	{0x1FA70, 0x1FA74, 2, BREAK_PICTOGRAPHIC},
+	{0x1FA75, 0x1FA77, 1, BREAK_PICTOGRAPHIC},
+	{0x1FA78, 0x1FA7C, 2, BREAK_PICTOGRAPHIC},
+	{0x1FA7D, 0x1FA7F, 1, BREAK_PICTOGRAPHIC},
+	{0x1FA80, 0x1FA86, 2, BREAK_PICTOGRAPHIC},
+	{0x1FA87, 0x1FA8F, 1, BREAK_PICTOGRAPHIC},
+	{0x1FA90, 0x1FAAC, 2, BREAK_PICTOGRAPHIC},
+	{0x1FAAD, 0x1FAAF, 1, BREAK_PICTOGRAPHIC},
+	{0x1FAB0, 0x1FABA, 2, BREAK_PICTOGRAPHIC},
+	{0x1FABB, 0x1FABF, 1, BREAK_PICTOGRAPHIC},
+	{0x1FAC0, 0x1FAC5, 2, BREAK_PICTOGRAPHIC},
+	{0x1FAC6, 0x1FACF, 1, BREAK_PICTOGRAPHIC},
+	{0x1FAD0, 0x1FAD9, 2, BREAK_PICTOGRAPHIC},
+	{0x1FADA, 0x1FADF, 1, BREAK_PICTOGRAPHIC},
+	{0x1FAE0, 0x1FAE7, 2, BREAK_PICTOGRAPHIC},
+	{0x1FAE8, 0x1FAEF, 1, BREAK_PICTOGRAPHIC},
+	{0x1FAF0, 0x1FAF6, 2, BREAK_PICTOGRAPHIC},
+	{0x1FAF7, 0x1FAFF, 1, BREAK_PICTOGRAPHIC},
+	{0x1FC00, 0x1FFFD, 1, BREAK_PICTOGRAPHIC},
+	{0x20000, 0x2FFFD, 2, BREAK_OTHER},
+	{0x30000, 0x3FFFD, 2, BREAK_OTHER},
+	{0xE0001, 0xE0001, 0, BREAK_CONTROL},
+	{0xE0020, 0xE007F, 0, BREAK_EXTEND},
+	{0xE0100, 0xE01EF, 0, BREAK_EXTEND},
+};
+
+const size_t RANGE_COUNT = sizeof RANGES / sizeof RANGES[0];
+};
+};
+
+#endif
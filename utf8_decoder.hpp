@@ -0,0 +1,99 @@
+#ifndef UTF8_DECODER_HPP
+#define UTF8_DECODER_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Blurses {
+// Incremental UTF-8 decoder. A sequence split between two calls to decode()
+// is completed by the next call, invalid input decodes to U+FFFD.
+class Utf8Decoder {
+	public:
+		static const uint32_t REPLACEMENT = 0xfffd;
+
+		Utf8Decoder() {
+			reset();
+		}
+
+		template <typename F>
+		void decode(const char *data, size_t len, F fn) {
+			const uint8_t *curr = reinterpret_cast<const uint8_t*>(data);
+			const uint8_t *end = curr + len;
+
+			while (curr != end) {
+				if (_needed == 0) {
+					while (curr != end && *curr < 0x80) {
+						fn(static_cast<uint32_t>(*curr++));
+					}
+
+					if (curr == end) {
+						break;
+					}
+
+					start(*curr++, fn);
+					continue;
+				}
+
+				const uint8_t c = *curr;
+
+				if ((c & 0xc0) != 0x80) {
+					// Truncated sequence, decode c again as the start of a new one.
+					reset();
+					fn(REPLACEMENT);
+					continue;
+				}
+
+				_codepoint = (_codepoint << 6) | (c & 0x3f);
+				curr++;
+
+				if (--_needed == 0) {
+					fn(isValid() ? _codepoint : REPLACEMENT);
+					reset();
+				}
+			}
+		}
+
+		bool pending() const {
+			return _needed != 0;
+		}
+
+		void reset() {
+			_codepoint = 0;
+			_min = 0;
+			_needed = 0;
+		}
+
+	private:
+		uint32_t _codepoint;
+		uint32_t _min;
+		uint8_t _needed;
+
+		template <typename F>
+		void start(uint8_t c, F fn) {
+			if (c >= 0xc2 && c <= 0xdf) {
+				_codepoint = c & 0x1f;
+				_min = 0x80;
+				_needed = 1;
+			} else if (c >= 0xe0 && c <= 0xef) {
+				_codepoint = c & 0x0f;
+				_min = 0x800;
+				_needed = 2;
+			} else if (c >= 0xf0 && c <= 0xf4) {
+				_codepoint = c & 0x07;
+				_min = 0x10000;
+				_needed = 3;
+			} else {
+				fn(REPLACEMENT);
+			}
+		}
+
+		bool isValid() const {
+			if (_codepoint < _min) { return false; }
+			if (_codepoint > 0x10ffff) { return false; }
+			if (_codepoint >= 0xd800 && _codepoint <= 0xdfff) { return false; }
+			return true;
+		}
+};
+};
+
+#endif
@@ -3,15 +3,118 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include <iterator>
+#include <algorithm>
 #include "vendor/utfcpp/source/utf8.h"
+#include "unicode.hpp"
+#include "simd_utf8.hpp"
 
 namespace Blurses {
+// Long strings get a grapheme offset index built on first positional
+// access, even from const member functions. A utfstring shared between
+// threads without a lock must have it built first, by calling length().
 class utfstring {
 	public:
-		utfstring() : _str("") { }
-		utfstring(const char* str) : _str(str) { }
-		utfstring(std::string str) : _str(str) { }
+		// A grapheme as a pointer into the string it was found in.
+		struct grapheme {
+			const char* data;
+			size_t size;
+			uint8_t width;
+
+			std::string str() const {
+				return std::string(data, size);
+			}
+
+			bool operator==(const grapheme& other) const {
+				return size == other.size && std::equal(data, data + size, other.data);
+			}
+
+			bool operator!=(const grapheme& other) const {
+				return !(*this == other);
+			}
+		};
+
+		class grapheme_iterator {
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef grapheme value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const grapheme* pointer;
+				typedef const grapheme& reference;
+
+				grapheme_iterator(const char* curr, const char* end)
+					: _end(end) {
+					read(curr);
+				}
+
+				const grapheme& operator*() const {
+					return _curr;
+				}
+
+				const grapheme* operator->() const {
+					return &_curr;
+				}
+
+				grapheme_iterator& operator++() {
+					read(_curr.data + _curr.size);
+					return *this;
+				}
+
+				grapheme_iterator operator++(int) {
+					grapheme_iterator it(*this);
+					++(*this);
+					return it;
+				}
+
+				bool operator==(const grapheme_iterator& other) const {
+					return _curr.data == other._curr.data;
+				}
+
+				bool operator!=(const grapheme_iterator& other) const {
+					return !(*this == other);
+				}
+
+			private:
+				grapheme _curr;
+				const char* _end;
+
+				void read(const char* curr) {
+					_curr.data = curr;
+					_curr.size = 0;
+					_curr.width = 0;
+
+					if (curr != _end) {
+						_curr.size = next_grapheme(curr, _end, &_curr.width) - curr;
+					}
+				}
+		};
+
+		class grapheme_range {
+			public:
+				grapheme_range(const char* start, const char* end) : _start(start), _end(end) { }
+
+				grapheme_iterator begin() const {
+					return grapheme_iterator(_start, _end);
+				}
+
+				grapheme_iterator end() const {
+					return grapheme_iterator(_end, _end);
+				}
+
+			private:
+				const char* _start;
+				const char* _end;
+		};
+
+		// Strings at least this long get a grapheme offset index on first
+		// positional access, with a checkpoint every INDEX_STRIDE graphemes.
+		static const size_t INDEX_THRESHOLD = 256;
+		static const size_t INDEX_STRIDE = 32;
+
+		utfstring() : _str(""), _indexed(false) { }
+		utfstring(const char* str) : _str(str), _indexed(false) { }
+		utfstring(std::string str) : _str(str), _indexed(false) { }
 
 		static utfstring decode(uint32_t codepoint) {
 			std::string str;
@@ -20,43 +123,72 @@ class utfstring {
 		}
 
 		int length() const {
-			return chars().size();
-		}
+			if (build_index()) {
+				return _length;
+			}
 
-		size_t find_offset2(size_t index) const {
-			return find_offset(index);
-		}
+			const char* curr = _str.data();
+			const char* end = curr + _str.length();
+			int count = 0;
 
-		std::list<utfstring> chars() const {
-			std::list<utfstring> list;
+			while (curr != end) {
+				const size_t ascii = ascii_graphemes(curr, end, end - curr);
 
-			char* start = strptr();
-			char* end = start + _str.length();
+				if (ascii > 0) {
+					curr += ascii;
+					count += ascii;
+					continue;
+				}
 
-			if (start == end) {
-				return list;
+				curr = next_grapheme(curr, end);
+				count++;
 			}
 
-			char* prev = start;
-			char* curr = start;
+			return count;
+		}
+
+		// Columns taken when printed to a terminal.
+		int width() const {
+			const char* curr = _str.data();
+			const char* end = curr + _str.length();
+			int columns = 0;
+
+			while (curr != end) {
+				const size_t ascii = ascii_graphemes(curr, end, end - curr);
 
-			while (utf8::next(curr, end)) {
-				while (curr != end && is_combining(utf8::peek_next(curr, end))) {
-					utf8::next(curr, end);
+				if (ascii > 0) {
+					curr += ascii;
+					columns += ascii;
+					continue;
 				}
 
-				list.push_back(_str.substr(prev - start, curr - prev));
+				uint8_t width;
+				curr = next_grapheme(curr, end, &width);
+				columns += width;
+			}
 
-				prev = curr;
+			return columns;
+		}
 
-				if (curr == end) {
-					break;
-				}
+		size_t find_offset2(size_t index) const {
+			return find_offset(index);
+		}
+
+		std::list<utfstring> chars() const {
+			std::list<utfstring> list;
+
+			for (const grapheme &ch : graphemes()) {
+				list.push_back(ch.str());
 			}
 
 			return list;
 		}
 
+		// Iterates graphemes in place, without copying them out of the string.
+		grapheme_range graphemes() const {
+			return grapheme_range(_str.data(), _str.data() + _str.length());
+		}
+
 		utfstring at(int pos) const {
 			return substr(pos, 1);
 		}
@@ -79,11 +211,13 @@ class utfstring {
 
 		utfstring& operator=(const utfstring &other) {
 			this->_str = other.str();
+			invalidate_index();
 			return *this;
 		}
 
 		utfstring& operator+=(const utfstring &other) {
 			this->_str += other.str();
+			invalidate_index();
 			return *this;
 		}
 
@@ -119,56 +253,158 @@ class utfstring {
 			return _str;
 		}
 
+		const char* data() const {
+			return _str.data();
+		}
+
+		size_t size() const {
+			return _str.size();
+		}
+
 		size_t find_offset(size_t index) const {
-			char* start = strptr();
-			char* end = start + _str.length();
-			char* prev = start;
-			char* curr = start;
+			const char* start = _str.data();
+			const char* end = start + _str.length();
+			const char* curr = start;
+			size_t i = 0;
 
-			if (start == end) {
-				return 0;
+			if (build_index()) {
+				const size_t checkpoint = std::min(index / INDEX_STRIDE, _index.size() - 1);
+				curr = start + _index[checkpoint];
+				i = checkpoint * INDEX_STRIDE;
 			}
 
-			size_t i = 0;
+			while (i < index && curr != end) {
+				const size_t ascii = ascii_graphemes(curr, end, index - i);
 
-			while (utf8::next(curr, end)) {
-				if (i++ >= index) {
-					break;
+				if (ascii > 0) {
+					curr += ascii;
+					i += ascii;
+					continue;
 				}
 
-				while (curr != end && is_combining(utf8::peek_next(curr, end))) {
-					utf8::next(curr, end);
-				}
+				curr = next_grapheme(curr, end);
+				i++;
+			}
+
+			return curr - start;
+		}
+
+		static bool is_valid(const std::string& str) {
+			const char *start = str.data();
+			const char *end = start + str.length();
+
+			return SimdUtf8::validate(start, end);
+		}
+
+		// Start of the grapheme after the one at curr. Its width in columns is
+		// stored in width if given.
+		static const char* next_grapheme(const char* curr, const char* end, uint8_t* width = nullptr) {
+			const uint8_t c = *curr;
+
+			if (c >= 0x20 && c < 0x7f && (curr + 1 == end || static_cast<uint8_t>(curr[1]) < 0x80)) {
+				if (width) { *width = 1; }
+				return curr + 1;
+			}
+
+			Unicode::GraphemeBreaker breaker;
+			uint32_t cp = utf8::next(curr, end);
+			uint8_t columns = Unicode::width(cp);
+			breaker.next(cp);
 
-				prev = curr;
+			while (curr != end) {
+				const char* prev = curr;
+				cp = utf8::next(curr, end);
 
-				if (curr == end) {
+				if (breaker.next(cp)) {
+					curr = prev;
 					break;
 				}
+
+				columns = std::max(columns, Unicode::width(cp));
 			}
 
-			return prev - start;
+			if (width) { *width = std::max<uint8_t>(columns, 1); }
+			return curr;
 		}
 
-		static bool is_valid(const std::string& str) {
-			const char *start = const_cast<char*>(str.c_str());
-			const char *end = start + str.length();
+		// Number of leading bytes, at most max, that are each a one column
+		// grapheme on their own. The last printable byte before a non-ASCII
+		// one is left out since a combining mark may follow it.
+		static size_t ascii_graphemes(const char* curr, const char* end, size_t max) {
+			if (end - curr < 2 || !SimdUtf8::isPrintableAscii(curr[0]) || !SimdUtf8::isPrintableAscii(curr[1])) {
+				return 0;
+			}
+
+			size_t len = SimdUtf8::printablePrefix(curr, end);
 
-			return utf8::is_valid(start, end);
+			if (curr + len != end && len > 0) {
+				len--;
+			}
+
+			return std::min(len, max);
 		}
 
 		static bool is_combining(int cp) {
-			return (
-				(cp >= 0x0300 && cp < 0x036f) || // Combining Diacritical Marks
-				(cp >= 0x1AB0 && cp < 0x1AFF) || // Combining Diacritical Marks Extended
-				(cp >= 0x1DC0 && cp < 0x1DFF) || // Combining Diacritical Marks Supplement
-				(cp >= 0x20D0 && cp < 0x20FF) || // Combining Diacritical Marks for Symbols
-				(cp >= 0xFE20 && cp < 0xFE2F)    // Combining Half Marks
-			);
+			switch (Unicode::graphemeBreak(cp)) {
+				case Unicode::BREAK_EXTEND:
+				case Unicode::BREAK_ZWJ:
+				case Unicode::BREAK_SPACING_MARK:
+					return true;
+				default:
+					return false;
+			}
 		}
 
 	private:
 		std::string _str;
+		mutable std::vector<uint32_t> _index;
+		mutable size_t _length;
+		mutable bool _indexed;
+
+		// Byte offsets of every INDEX_STRIDE:th grapheme, built lazily for long
+		// strings. Returns false if the string is too short to bother.
+		bool build_index() const {
+			if (_indexed) {
+				return true;
+			}
+
+			if (_str.length() < INDEX_THRESHOLD) {
+				return false;
+			}
+
+			const char* start = _str.data();
+			const char* end = start + _str.length();
+			const char* curr = start;
+
+			_index.clear();
+			_length = 0;
+
+			while (curr != end) {
+				if (_length % INDEX_STRIDE == 0) {
+					_index.push_back(curr - start);
+				}
+
+				// Skip ASCII up to the next checkpoint in one step.
+				const size_t ascii = ascii_graphemes(curr, end, INDEX_STRIDE - _length % INDEX_STRIDE);
+
+				if (ascii > 0) {
+					curr += ascii;
+					_length += ascii;
+					continue;
+				}
+
+				curr = next_grapheme(curr, end);
+				_length++;
+			}
+
+			_indexed = true;
+			return true;
+		}
+
+		void invalidate_index() {
+			_indexed = false;
+			_index.clear();
+		}
 
 		char* strptr() const {
 			return const_cast<char*>(_str.c_str());
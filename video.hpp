@@ -0,0 +1,493 @@
+#ifndef VIDEO_HPP
+#define VIDEO_HPP
+
+#include <vector>
+#include <string>
+#include <cctype>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "display.hpp"
+#include "ring_buffer.hpp"
+
+namespace Blurses {
+struct Image {
+	uint16_t width = 0;
+	uint16_t height = 0;
+	std::vector<uint8_t> rgb;
+};
+
+// Reads binary PPM (P6) and PGM (P5) frames one after another from a file
+// descriptor, as written by e.g. ffmpeg -f image2pipe -c:v ppm.
+class PnmReader {
+	public:
+		PnmReader(int fd) : _fd(fd), _position(0), _length(0), _eof(false) { }
+
+		// Returns false at the end of the stream, on malformed input, or
+		// when running is cleared while waiting for data.
+		bool read(Image &image, const std::atomic<bool> &running) {
+			if (!token(running) || _token.size() != 2 || _token[0] != 'P') {
+				return false;
+			}
+
+			const char kind = _token[1];
+
+			if (kind != '5' && kind != '6') {
+				return false;
+			}
+
+			if (!token(running)) { return false; }
+			const long width = std::atol(_token.c_str());
+			if (!token(running)) { return false; }
+			const long height = std::atol(_token.c_str());
+			if (!token(running)) { return false; }
+			const long maxval = std::atol(_token.c_str());
+
+			if (width <= 0 || height <= 0 || width > 0xffff || height > 0xffff || maxval <= 0 || maxval > 0xffff) {
+				return false;
+			}
+
+			const size_t channels = kind == '6' ? 3 : 1;
+			const size_t sample = maxval > 255 ? 2 : 1;
+			const size_t pixels = width * height;
+
+			image.width = width;
+			image.height = height;
+			image.rgb.resize(pixels * 3);
+			_row.resize(width * channels * sample);
+
+			for (long y = 0; y < height; y++) {
+				if (!fill(_row.data(), _row.size(), running)) {
+					return false;
+				}
+
+				uint8_t* out = &image.rgb[y * width * 3];
+
+				for (long x = 0; x < width; x++) {
+					for (size_t c = 0; c < 3; c++) {
+						// Grayscale repeats its one channel, 16 bit samples
+						// are read big endian.
+						const size_t i = (x * channels + (channels == 3 ? c : 0)) * sample;
+						const long value = sample == 2 ? (_row[i] << 8 | _row[i + 1]) : _row[i];
+						out[x * 3 + c] = maxval == 255 ? value : value * 255 / maxval;
+					}
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		const int _fd;
+		uint8_t _buffer[65536];
+		size_t _position;
+		size_t _length;
+		bool _eof;
+		std::string _token;
+		std::vector<uint8_t> _row;
+
+		int next(const std::atomic<bool> &running) {
+			if (_position == _length && !refill(running)) {
+				return -1;
+			}
+
+			return _buffer[_position++];
+		}
+
+		bool refill(const std::atomic<bool> &running) {
+			while (running && !_eof) {
+				pollfd pfd = {_fd, POLLIN, 0};
+
+				if (::poll(&pfd, 1, 100) <= 0) {
+					continue;
+				}
+
+				const ssize_t length = ::read(_fd, _buffer, sizeof _buffer);
+
+				if (length <= 0) {
+					_eof = true;
+					return false;
+				}
+
+				_position = 0;
+				_length = length;
+				return true;
+			}
+
+			return false;
+		}
+
+		// Reads a header field, skipping whitespace and comments. The single
+		// whitespace character after it is consumed too.
+		bool token(const std::atomic<bool> &running) {
+			int c = next(running);
+			_token.clear();
+
+			while (c == '#' || std::isspace(c)) {
+				if (c == '#') {
+					while (c != '\n' && c != -1) {
+						c = next(running);
+					}
+				}
+
+				c = next(running);
+			}
+
+			while (c != -1 && !std::isspace(c)) {
+				_token += static_cast<char>(c);
+				c = next(running);
+			}
+
+			return !_token.empty();
+		}
+
+		bool fill(uint8_t* data, size_t size, const std::atomic<bool> &running) {
+			while (size > 0) {
+				if (_position == _length && !refill(running)) {
+					return false;
+				}
+
+				const size_t count = std::min(size, _length - _position);
+				std::copy(_buffer + _position, _buffer + _position + count, data);
+				_position += count;
+				data += count;
+				size -= count;
+			}
+
+			return true;
+		}
+};
+
+// Plays a stream of PNM frames at a fixed frame rate. One thread reads
+// frames, another downscales them by area averaging to the cell grid (or
+// two pixels per cell with half blocks) and quantizes them with the
+// display's colors. draw() shows the newest ready frame. Frames move
+// between the threads as slot indices through ring buffers, so nothing
+// is allocated once the first frames have been seen. A late frame restarts
+// the pacing from the current time, and is dropped if a newer one is
+// already waiting. Frames that find no free slot are dropped too.
+class VideoPlayer {
+	public:
+		enum GRID {
+			CELL,
+			HALF_BLOCK
+		};
+
+		VideoPlayer(const Display &display, int fd, uint16_t columns, uint16_t rows, float fps, GRID grid = HALF_BLOCK)
+			: _display(display)
+			, _reader(fd)
+			, _columns(columns)
+			, _rows(rows)
+			, _grid(grid)
+			, _frame_interval(std::chrono::microseconds(static_cast<long>(1000000 / fps)))
+			, _free_images(RingBuffer<size_t, SLOTS>::BLOCK)
+			, _free_pictures(RingBuffer<size_t, SLOTS>::BLOCK)
+			, _current(SLOTS)
+			, _running(false)
+			, _read_done(false)
+			, _scale_done(false)
+			, _decoded(0)
+			, _dropped(0)
+			, _shown(0) {
+			for (size_t i = 0; i < SLOTS; i++) {
+				_free_images.push(i);
+				_free_pictures.push(i);
+				_pictures[i].resize(_columns * pixelRows());
+			}
+		}
+
+		~VideoPlayer() {
+			stop();
+		}
+
+		void start() {
+			_running = true;
+			_read_thread = std::thread([this]() { readLoop(); });
+			_scale_thread = std::thread([this]() { scaleLoop(); });
+		}
+
+		void stop() {
+			_running = false;
+			// Lets a producer blocked on a full free ring give up, since the
+			// threads draining them are about to end.
+			_free_images.close();
+			_free_pictures.close();
+
+			if (_read_thread.joinable()) { _read_thread.join(); }
+			if (_scale_thread.joinable()) { _scale_thread.join(); }
+		}
+
+		// Shows the newest ready frame, or the last one again. Ready frames
+		// older than the newest are dropped.
+		void draw(Display &display, int x, int y) {
+			size_t newest = SLOTS;
+			size_t stale[SLOTS];
+			size_t count = 0;
+
+			_ready.drain([&](size_t slot) {
+				if (newest != SLOTS) {
+					stale[count++] = newest;
+				}
+
+				newest = slot;
+			});
+
+			// Slots are only handed back once drain() has released them, so
+			// a ring never holds more than SLOTS of them.
+			for (size_t i = 0; i < count; i++) {
+				_free_pictures.push(stale[i]);
+				_dropped++;
+			}
+
+			if (newest != SLOTS) {
+				if (_current != SLOTS) {
+					_free_pictures.push(_current);
+				}
+
+				_current = newest;
+				_shown++;
+			}
+
+			if (_current == SLOTS) {
+				return;
+			}
+
+			const std::vector<RealColor> &pixels = _pictures[_current];
+			Cell cell;
+			cell.data = _grid == HALF_BLOCK ? "▀" : " ";
+
+			for (uint16_t row = 0; row < _rows; row++) {
+				Buffer::Span span = display.span(y + row, x, x + _columns - 1);
+
+				for (uint16_t i = 0; i < span.size(); i++) {
+					const uint16_t column = span.x() - x + i;
+
+					if (_grid == HALF_BLOCK) {
+						cell.fg = pixels[(row * 2) * _columns + column];
+						cell.bg = pixels[(row * 2 + 1) * _columns + column];
+					} else {
+						cell.bg = pixels[row * _columns + column];
+					}
+
+					span.set(i, cell);
+				}
+			}
+		}
+
+		// Whether the stream has ended and its last frame has been handed
+		// to draw().
+		bool finished() const {
+			return _scale_done && _ready.empty();
+		}
+
+		size_t decoded() const {
+			return _decoded;
+		}
+
+		size_t dropped() const {
+			return _dropped;
+		}
+
+		size_t shown() const {
+			return _shown;
+		}
+
+	private:
+		static const size_t SLOTS = 4;
+
+		const Display &_display;
+		PnmReader _reader;
+		const uint16_t _columns;
+		const uint16_t _rows;
+		const GRID _grid;
+		const std::chrono::microseconds _frame_interval;
+
+		Image _images[SLOTS];
+		std::vector<RealColor> _pictures[SLOTS];
+		// Slots flow reader -> _decoded -> scaler -> _ready -> draw(), and
+		// back through the free rings.
+		RingBuffer<size_t, SLOTS> _decoded_images;
+		RingBuffer<size_t, SLOTS> _free_images;
+		RingBuffer<size_t, SLOTS> _ready;
+		RingBuffer<size_t, SLOTS> _free_pictures;
+		size_t _current;
+
+		std::atomic<bool> _running;
+		std::atomic<bool> _read_done;
+		std::atomic<bool> _scale_done;
+		std::atomic<size_t> _decoded;
+		std::atomic<size_t> _dropped;
+		std::atomic<size_t> _shown;
+		std::thread _read_thread;
+		std::thread _scale_thread;
+
+		std::vector<uint32_t> _sums;
+		std::vector<std::pair<uint32_t, uint32_t> > _columns_at;
+
+		uint16_t pixelRows() const {
+			return _grid == HALF_BLOCK ? _rows * 2 : _rows;
+		}
+
+		void readLoop() {
+			size_t free[SLOTS];
+			size_t available = 0;
+
+			while (_running) {
+				if (available == 0) {
+					_free_images.drain([&](size_t slot) { free[available++] = slot; });
+
+					if (available == 0) {
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+						continue;
+					}
+				}
+
+				const size_t slot = free[--available];
+
+				if (!_reader.read(_images[slot], _running)) {
+					break;
+				}
+
+				_decoded++;
+				_decoded_images.push(slot);
+			}
+
+			_free_images.close();
+			_read_done = true;
+		}
+
+		void scaleLoop() {
+			size_t free[SLOTS];
+			size_t available = 0;
+			size_t slots[SLOTS];
+			size_t frame = 0;
+			auto start = std::chrono::steady_clock::now();
+
+			while (_running) {
+				const bool done = _read_done;
+				size_t count = 0;
+
+				// Taken out of the ring before pacing, so the reader can
+				// decode the next frames while this thread sleeps.
+				_decoded_images.drain([&](size_t slot) { slots[count++] = slot; });
+
+				for (size_t i = 0; i < count && _running; i++) {
+					const auto now = std::chrono::steady_clock::now();
+					const bool late = frame > 0 && now > start + _frame_interval * (frame + 1);
+					auto due = start + _frame_interval * frame++;
+
+					if (frame == 1 || late) {
+						// First frame, or late after a stall. Pace from now on,
+						// instead of dropping every frame of the old schedule.
+						start = due = now;
+						frame = 1;
+
+						if (late && i + 1 < count) {
+							// A newer frame is already waiting.
+							_dropped++;
+							_free_images.push(slots[i]);
+							continue;
+						}
+					}
+
+					if (available == 0) {
+						_free_pictures.drain([&](size_t picture) { free[available++] = picture; });
+					}
+
+					if (available == 0) {
+						_dropped++;
+						_free_images.push(slots[i]);
+						continue;
+					}
+
+					const size_t picture = free[--available];
+					scale(_images[slots[i]], _pictures[picture]);
+					_free_images.push(slots[i]);
+
+					if (wait(due)) {
+						_ready.push(picture);
+					}
+				}
+
+				if (count == 0) {
+					if (done) {
+						break;
+					}
+
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+
+			_free_pictures.close();
+			_scale_done = true;
+		}
+
+		// Sleeps until due in short steps, so stop() doesn't wait for a long
+		// frame interval. Returns false when stopped.
+		bool wait(std::chrono::steady_clock::time_point due) const {
+			while (_running) {
+				const auto left = due - std::chrono::steady_clock::now();
+
+				if (left <= std::chrono::steady_clock::duration::zero()) {
+					return true;
+				}
+
+				std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(left, std::chrono::milliseconds(10)));
+			}
+
+			return false;
+		}
+
+		// Area average of the source pixels that fall in each target pixel.
+		// When scaling down every source pixel is read once.
+		void scale(const Image &image, std::vector<RealColor> &pixels) {
+			const uint16_t width = _columns;
+			const uint16_t height = pixelRows();
+
+			_columns_at.resize(width);
+
+			for (uint16_t x = 0; x < width; x++) {
+				const uint32_t first = uint32_t(x) * image.width / width;
+				const uint32_t last = std::max(first + 1, uint32_t(x + 1) * image.width / width);
+				_columns_at[x] = {first, last};
+			}
+
+			_sums.resize(width * 3);
+
+			for (uint16_t y = 0; y < height; y++) {
+				const uint32_t first = uint32_t(y) * image.height / height;
+				const uint32_t last = std::max(first + 1, uint32_t(y + 1) * image.height / height);
+
+				std::fill(_sums.begin(), _sums.end(), 0);
+
+				for (uint32_t sy = first; sy < last; sy++) {
+					const uint8_t* row = &image.rgb[sy * image.width * 3];
+
+					for (uint16_t x = 0; x < width; x++) {
+						for (uint32_t sx = _columns_at[x].first; sx < _columns_at[x].second; sx++) {
+							_sums[x * 3 + 0] += row[sx * 3 + 0];
+							_sums[x * 3 + 1] += row[sx * 3 + 1];
+							_sums[x * 3 + 2] += row[sx * 3 + 2];
+						}
+					}
+				}
+
+				for (uint16_t x = 0; x < width; x++) {
+					const uint32_t count = (last - first) * (_columns_at[x].second - _columns_at[x].first);
+
+					pixels[y * width + x] = _display.color(Color(
+						_sums[x * 3 + 0] / count,
+						_sums[x * 3 + 1] / count,
+						_sums[x * 3 + 2] / count
+					));
+				}
+			}
+		}
+};
+};
+
+#endif